@@ -4,9 +4,9 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <vector>
-#include <list>
 #include <map>
 #include <string>
+#include <functional>
 
 // === NOUVEAUX INCLUDES POUR LA 3D ===
 #include <glm/glm.hpp>
@@ -14,7 +14,20 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "commons/GLShader.h"
+#include "commons/DynamicAABBTree.h"
+#include "commons/SpatialHashGrid.h"
+#include "commons/SpscRing.h"
+#include "commons/PolygonMask.h"
 #include "../include/bezier/BezierCurve.h"
+#include "bezier/CurveStore.h"
+#include "bezier/SceneGraph.h"
+#include "bezier/CurveChain.h"
+#include "bezier/CurveIntersector.h"
+#include "bezier/EditHistory.h"
+#include "bezier/SnapEngine.h"
+#include "bezier/PointSelection.h"
+#include "clipping/ClipWindow.h"
+#include "clipping/SutherlandHodgman.h"
 #include "ui/ImGuiManager.h"
 #include "imgui.h"
 #include "libs/imfilebrowser.h"
@@ -128,7 +141,9 @@ public:
         ADD_CONTROL_POINTS = 0,
         EDIT_CONTROL_POINTS = 1,
         CREATE_CLIP_WINDOW = 2,
-        EDIT_CLIP_WINDOW = 3
+        EDIT_CLIP_WINDOW = 3,
+        SELECT_CURVES = 4,
+        SELECT_POINTS = 5
     };
 
     enum class CursorMode {
@@ -195,25 +210,100 @@ private:
     GLuint cursorVAO, cursorVBO;
     bool isPointHovered;
     int hoveredPointIndex;
+    CurveHandle hoveredCurve; // courbe du point survolé (peut différer de la courbe courante en édition)
     CursorMode cursorMode;
 
-    std::list<BezierCurve> curves;
-    std::list<BezierCurve>::iterator selectedCurveIterator;
+    CurveStore curves;
+    CurveHandle selectedCurve;
+    SceneGraph sceneGraph;
+    CurveChain::Continuity chainContinuity = CurveChain::Continuity::C1;
+
+    // Hiérarchie de boîtes englobantes des courbes (picking, sélection, découpage, intersections).
+    // Une feuille par courbe, indexée par l'emplacement de son handle dans le CurveStore ; seules
+    // les courbes du journal de modifications du store sont réajustées (voir syncCurveIndexes).
+    struct CurveProxy {
+        int proxyId = DynamicAABBTree::NULL_NODE;
+        uint32_t generation = 0;
+    };
+    DynamicAABBTree curveTree;
+    std::vector<CurveProxy> curveProxies;
+    std::vector<uint32_t> changedCurveSlots; // tampon de CurveStore::takeChanges
+    std::vector<uint8_t> clipCandidates; // courbes touchant la fenêtre de découpage (par emplacement)
+    // Découpage Sutherland-Hodgman par lots des courbes fermées, tampons gardés d'une image à l'autre
+    std::vector<SutherlandHodgman::Subject> clipSubjects;
+    std::vector<BezierCurve*> clipSubjectCurves;
+    std::vector<std::vector<Point>> clippedPolygons;
+    std::vector<SutherlandHodgman::Scratch> clipArenas;
+    struct ClipBatchStats {
+        size_t curves = 0; // courbes découpées par le dernier lot
+        size_t points = 0; // sommets des polygones obtenus
+    };
+    ClipBatchStats clipBatchStats;
+
+    // Détection de toutes les paires de courbes en intersection
+    CurveIntersector curveIntersector;
+    std::vector<CurveIntersector::CurvePair> intersectingPairs;
+    bool intersectionStatsValid = false;
+
+    // Annuler / rétablir (Ctrl+Z, Ctrl+Y ou Ctrl+Shift+Z)
+    EditHistory history;
+
+    // Multi-sélection de courbes (transformations groupées)
+    std::vector<CurveHandle> selectedCurves;
+    // Appartenance à la sélection en O(1), par emplacement : génération + 1 de la courbe
+    // sélectionnée, 0 sinon (un emplacement réutilisé n'hérite pas de la sélection)
+    std::vector<uint32_t> selectedCurveMarks;
+    bool isBoxSelecting = false;
+    Point boxSelectStart;
+
+    // Sélection de points de contrôle sur toutes les courbes (Maj+J) : rectangle, ou lasso avec Alt
+    PointSelection pointSelection;
+    bool isLassoSelecting = false;
+    std::vector<Point> lassoPoints;
+    PolygonMask lassoMask;
 
     Mode currentMode;
     int selectedPointIndex;
     bool menuNeedsUpdate = true;
 
     // Clipping
-    std::vector<Point> clipWindow;
+    // Sommets et données dérivées (convexité, normales...) recalculées à chaque modification
+    // seulement ; sa version sert de clé aux découpages gardés par les courbes
+    ClipWindow clipWindow;
     int selectedClipPointIndex = -1;
     bool enableClipping = false;
     int hoveredClipPointIndex = -1;
 
+    // Index spatial des points de contrôle de toutes les courbes et des sommets de la fenêtre
+    // de découpage (survol et sélection en temps constant)
+    static constexpr uint64_t CLIP_POINT_TAG = 1ull << 63;
+    static uint64_t curvePointId(uint32_t slot, int index) {
+        return (static_cast<uint64_t>(slot) << 32) | static_cast<uint32_t>(index);
+    }
+    static uint64_t clipPointId(int index) { return CLIP_POINT_TAG | static_cast<uint32_t>(index); }
+    struct PointGridCurve {
+        uint32_t generation = 0;
+        uint64_t version = UINT64_MAX; // version de la courbe lors de la dernière indexation
+        int count = 0;                 // points indexés
+    };
+    SpatialHashGrid pointGrid;
+    std::vector<PointGridCurve> pointGridCurves; // par emplacement du CurveStore
+    int clipGridCount = 0;
+    // Arêtes de la fenêtre de découpage (aimantation), arête i : sommets i et i + 1
+    DynamicAABBTree clipEdgeTree{0.0f};
+    std::vector<int> clipEdgeProxies;
+
+    // Aimantation (Maj+G) : mouseX / mouseY prennent la position aimantée pendant les éditions
+    SnapEngine snapEngine;
+    SnapEngine::Snap currentSnap;
+    bool snapActive = false;
+    float rawMouseX = 0.0f, rawMouseY = 0.0f;
+
     ImGuiManager imguiManager;
     float selectionPadding = 0.03f;
     std::map<std::string, std::string> commandDescriptions;
-    bool usesSutherlandHodgman;
+    BezierCurve::ClippingAlgorithm clippingAlgorithm; // appliqué aux nouvelles courbes
+    bool compactStorage = false; // Stockage quantifié des courbes (scènes en lecture seule)
 
     // === 3D MEMBERS ===
     RenderMode3D renderMode3D = RenderMode3D::SOLID_WITH_LIGHTING;
@@ -232,6 +322,7 @@ private:
     Surface3D currentSurface;
     TriangularSurface triangularSurface; // MOVED HERE
     bool surfaceGenerated = false;
+    bool cutProfileLoops = false; // Retirer les boucles des profils avant l'extrusion
 
     // Lighting
     glm::vec3 lightPos = glm::vec3(2.0f, 2.0f, 2.0f);
@@ -247,6 +338,29 @@ private:
     GLuint loadTexture(const std::string& path);
     void renderTextureControls();
 
+    // Événements d'entrée : les callbacks GLFW les déposent dans une file sans verrou,
+    // run() la vide une fois par image en fusionnant les déplacements du curseur
+    struct InputEvent {
+        enum class Type : uint8_t { CURSOR_MOVE, MOUSE_BUTTON, KEY, SCROLL };
+        Type type;
+        int code;      // bouton ou touche
+        int action;
+        int mods;
+        int scancode;
+        double x, y;   // position du curseur ou décalage de la molette
+    };
+    struct InputStats {
+        size_t received = 0;  // événements reçus pendant la dernière image
+        size_t processed = 0; // événements réellement traités après fusion
+    };
+    SpscRing<InputEvent, 1024> inputEvents;
+    std::vector<InputEvent> inputOverflow; // événements arrivés file pleine (voir pushInputEvent)
+    InputStats inputStats;
+    size_t droppedInputEvents = 0; // déplacements du curseur fusionnés faute de place
+
+    void pushInputEvent(const InputEvent& event);
+    void drainInputEvents();
+
     // Camera controls
     bool cameraControlEnabled = false;
     bool firstMouse = true;
@@ -267,6 +381,7 @@ private:
     void setMode(Mode newMode);
 
     void cursorPositionCallback(double xpos, double ypos);
+    void scrollCallback(double xoffset, double yoffset);
     virtual void mouseButtonCallback(int button, int action, int mods);
     virtual void keyCallback(int key, int scancode, int action, int mods);
 
@@ -277,10 +392,68 @@ private:
     bool checkPointHover(float x, float y);
     void selectNearestClipPoint(float x, float y);
     bool checkClipPointHover(float x, float y);
+    void syncPointGrid();
+    void reindexCurvePoints(uint32_t slot, CurveHandle handle, const BezierCurve* curve);
+    void updatePointGrid(CurveHandle curve, int index, uint64_t previousVersion);
+    void syncClipGrid(int first);
+    void moveClipVertex(int index);
+    void updateClipEdge(int edge);
+    void setupSnapProviders();
+    void updateSnap();
     void clearClipWindow();
 
+    // Multi-sélection
+    CurveHandle pickCurve(float x, float y);
+    // Courbe dont le tracé passe le plus près du clic (à moins du rayon de sélection), avec t et la distance
+    CurveHandle pickCurveHit(float x, float y, CurveHit& hit, float radius, CurveHandle exclude = CurveHandle());
+    void insertControlPointOnCurve(float x, float y);
+    void selectCurve(CurveHandle curve, bool toggle);
+    void selectCurvesInBox(const Point& corner1, const Point& corner2, bool additive);
+    void selectAllCurves();
+    void clearCurveSelection();
+    bool isCurveSelected(CurveHandle curve) const;
+    void setCurveMark(CurveHandle curve, bool selected);
+    Point getSelectionCenter() const;
+    void transformSelection(const Affine2D& m);
+    void bakeSelection();
+
+    // Sélection de points
+    void selectPoints(const AABB& area, const std::function<bool(const Point&)>& inside,
+                      const std::function<bool(const AABB&)>& containsBox, bool additive);
+    void selectPointsInBox(const Point& corner1, const Point& corner2, bool additive);
+    void selectPointsInLasso(const std::vector<Point>& polygon, bool additive);
+    void selectAllPoints();
+    Point getPointSelectionCenter();
+    void transformSelectedPoints(const Affine2D& m);
+    void deleteSelectedPoints();
+    void renderPointSelection();
+    void flushCurveUpdates();
+
+    // Hiérarchie de boîtes englobantes
+    // Arbre des courbes et grille des points, d'après le journal du CurveStore
+    void syncCurveIndexes();
+    void refitCurveProxy(uint32_t slot, CurveHandle handle, const BezierCurve* curve);
+    std::vector<CurveHandle> queryCurvesInBox(const Point& minPoint, const Point& maxPoint);
+    std::vector<CurveHandle> findIntersectingCurves(CurveHandle curve);
+    void printCurveIntersections(CurveHandle curve);
+    void detectAllIntersections();
+    void drawCurves();
+
+    // Groupes
+    void groupSelection();
+    void ungroupCurrentCurve();
+    void transformGroup(SceneGraph::GroupId group, const Affine2D& m);
+
+    // Historique
+    void recordCurveTransform(CurveHandle curve, const Affine2D& before);
+    void undoEdit();
+    void redoEdit();
+    void afterHistoryChange();
+    void renderSelection();
+
     void saveCurvesToFile();
     void loadCurvesFromFile();
+    void setCompactStorage(bool enabled);
 
     // Initialiser les descriptions des commandes
     void initCommandDescriptions();
@@ -300,10 +473,11 @@ private:
     void generateGeneralizedExtrusion();
     void calculateSurfaceNormals();
     std::vector<Point> getCurvePoints(const BezierCurve& curve) const;
+    bool checkProfileLoops(const BezierCurve& curve, std::vector<Point>& profile, const char* role) const;
 
     // ADD THESE MISSING METHODS:
     std::vector<Point> getCurvePointsFromCurve(const BezierCurve& curve) const;
-    void bridgeCurvesSequentially();
+    void bridgeCurvesSequentially(); // Raccorde toutes les courbes (ou la sélection) avec chainContinuity
     void bridgeMultipleCurves(); // ADD THIS
     void generateRuledSurfaceBridge(); // MOVED HERE
 
@@ -323,6 +497,7 @@ private:
     std::string getViewModeString() const;
     std::string getRenderMode3DString() const;
     std::string getExtrusionTypeString() const;
+    std::string getClippingAlgorithmString() const;
 };
 
 // === INLINE IMPLEMENTATIONS ===
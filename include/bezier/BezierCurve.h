@@ -2,26 +2,61 @@
 #define BEZIER_CURVE_H
 
 #include <vector>
+#include <span>
+#include <memory_resource>
+#include <cstdint>
 #include <GL/glew.h>
 #include "../commons/GLShader.h"
 #include "../commons/Point.h"
+#include "../commons/Affine2D.h"
+#include "../commons/DynamicAABBTree.h"
+#include "../clipping/ClipWindow.h"
+#include "../clipping/ClippedPolylines.h"
+#include "CompactControlPoints.h"
+#include "CurveChangeLog.h"
+#include "BezierIntersection.h"
 
+// Point de la courbe le plus proche d'un clic (repère de la scène)
+struct CurveHit {
+    float t = 0.0f;
+    float distance = 0.0f;
+    Point point;
+};
+
+// Points de contrôle et échantillons d'une courbe, alloués dans une arène du CurveStore
+using PointArray = std::pmr::vector<Point>;
 
 
 class BezierCurve {
 public:
-    BezierCurve();
+    // Les points de contrôle et les échantillons sont alloués dans les arènes données, que la
+    // courbe garde lorsqu'elle est déplacée (voir CurveStore)
+    explicit BezierCurve(std::pmr::memory_resource* controlPointArena = std::pmr::get_default_resource(),
+                         std::pmr::memory_resource* sampleArena = std::pmr::get_default_resource());
     ~BezierCurve();
 
+    // Les buffers OpenGL appartiennent à une seule courbe : déplaçable, non copiable
+    BezierCurve(BezierCurve&& other) noexcept;
+    BezierCurve& operator=(BezierCurve&& other) noexcept;
+    BezierCurve(const BezierCurve&) = delete;
+    BezierCurve& operator=(const BezierCurve&) = delete;
+
+    // Cyrus-Beck et Sutherland-Hodgman supposent une fenêtre convexe : pour une fenêtre concave
+    // ou auto-intersectante, ils passent la main au découpage général (Greiner-Hormann)
     enum class ClippingAlgorithm {
         CYRUS_BECK,
-        SUTHERLAND_HODGMAN
+        SUTHERLAND_HODGMAN,
+        GREINER_HORMANN
     };
 
     // Méthodes de gestion des points de contrôle
     void addControlPoint(float x, float y);
     void closeCurve();
+    // Insère un point (coordonnées scène) avant le point d'indice index (index == nombre de points : ajout en fin)
+    void insertControlPoint(int index, float x, float y);
     void updateControlPoint(int index, float x, float y);
+    // Remplace tous les points (coordonnées de la scène) ; recalcul différé (voir requestUpdate)
+    void setControlPoints(const std::vector<Point>& points);
     void removeControlPoint(int index);
     void clearControlPoints();
     Point getControlPoint(int index) const;
@@ -29,10 +64,11 @@ public:
     int getNearestControlPoint(float x, float y) const;
     int getControlPointCount() const;
 
-    // Méthodes de gestion du pas
+    // Méthodes de gestion du pas (pas dyadique : 1 / 2^niveau)
     void increaseStep();
     void decreaseStep();
     float getStep() const;
+    int getStepLevel() const;
 
     // Méthodes de calcul des courbes
     void calculateDirectMethod();
@@ -46,20 +82,57 @@ public:
     bool isShowingDirectMethod() const;
     bool isShowingDeCasteljau() const;
     //void draw(GLShader& shader);
-    void draw(GLShader& shader, const std::vector<Point>* clipWindow = nullptr);
+    // Le résultat du découpage reste sur le GPU tant que ni la courbe, ni la version de la
+    // fenêtre, ni l'algorithme ne changent
+    void draw(GLShader& shader, const ClipWindow* clipWindow = nullptr);
 
-    // Méthodes de transformation
+    // Méthodes de transformation (composées dans la matrice de la courbe, sans recalcul)
     void translate(float dx, float dy);
     void scale(float sx, float sy);
     void rotate(float angle);
     void shear(float shx, float shy);
+    void applyTransform(const Affine2D& m);      // m exprimée dans le repère du groupe parent
+    void applyWorldTransform(const Affine2D& m); // m exprimée dans le repère de la scène
+    const Affine2D& getTransform() const;
+    // Transformation monde du groupe parent (fournie par le SceneGraph)
+    void setParentTransform(const Affine2D& m);
+    const Affine2D& getParentTransform() const;
+    Affine2D getWorldTransform() const;
+    // Convertit des échantillons (repère local) dans le repère de la scène
+    void localToWorld(std::vector<Point>& points) const;
+    // Applique la matrice aux points de contrôle (avant une modification de la topologie ou un export)
+    void bakeTransform();
+    // Boîte englobante (transformée) du polygone de contrôle, false si la courbe est vide
+    bool getBounds(Point& minPoint, Point& maxPoint) const;
+    // Compteur incrémenté à chaque modification de la géométrie (points, matrices, pas)
+    uint64_t getVersion() const;
+    // Journal prévenu à chaque changement de version, sous l'emplacement slot (fixé par le CurveStore)
+    void setChangeLog(CurveChangeLog* log, uint32_t slot);
+
+    // Mise à jour différée des échantillons et des buffers, effectuée une fois par image
+    void requestUpdate();
+    bool hasPendingUpdate() const;
+    void flushPendingUpdate();
 
     // Méthodes pour la multiplicité
     void duplicateControlPoint(int index);
 
-    // Méthodes pour l'enveloppe convexe
+    // Méthodes pour l'enveloppe convexe (repère de la scène, sens trigonométrique).
+    // L'enveloppe est gardée en cache et mise à jour incrémentalement par les modifications de points.
     std::vector<Point> computeConvexHull() const;
     bool intersectsWithCurve(const BezierCurve& other) const;
+    // Test sur des enveloppes déjà calculées (phase fine de la détection d'intersections)
+    static bool hullsIntersect(const std::vector<Point>& hull1, const std::vector<Point>& hull2);
+    // Points d'intersection exacts (découpage de Bézier), dans le repère de la scène
+    std::vector<CurveIntersection> computeIntersections(const BezierCurve& other, float tolerance = 1e-5f) const;
+    // Boucles de la courbe (points dans le repère de la scène). Le résultat est mis en cache et
+    // n'est recalculé qu'après une modification des points : les transformations n'y changent rien.
+    std::vector<SelfIntersection> getSelfIntersections() const;
+    bool hasSelfIntersections() const;
+    // Point de la courbe le plus proche de p à moins de radius (repère de la scène).
+    // Les segments de la tessellation sont rangés dans une hiérarchie de boîtes construite à la
+    // demande ; le paramètre est ensuite affiné sur la courbe exacte.
+    bool pick(const Point& p, float radius, CurveHit& hit) const;
 
     // Méthodes pour le raccordement
     void joinC0(BezierCurve& other);
@@ -67,32 +140,66 @@ public:
     void joinC2(BezierCurve& other);
 
     // Méthode pour découper une courbe de Bézier fermée (considérée comme un polygone)
-    std::vector<Point> clipClosedCurveWithSH(const std::vector<Point>& clipWindow) const;
+    std::vector<Point> clipClosedCurveWithSH(const ClipWindow& clipWindow) const;
 
     // Méthode pour dessiner une courbe découpée avec Sutherland-Hodgman
     void drawClippedWithSH(GLShader& shader, const std::vector<Point>& clippedPolygon);
 
+    // Découpage Sutherland-Hodgman par lots (voir SutherlandHodgman::clipPolygons) : points de la
+    // courbe (repère local) si son polygone découpé par cette fenêtre doit être recalculé, vide sinon
+    std::span<const Point> polygonClipSubject(const ClipWindow& clipWindow);
+    // Garde en cache, pour cette fenêtre, le polygone découpé (repère de la scène) calculé par lots
+    void setClippedPolygon(const ClipWindow& clipWindow, const std::vector<Point>& clippedPolygon);
+
     // Méthode pour vérifier si une courbe est fermée
     bool isClosedCurve() const;
 
     void setClippingAlgorithm(ClippingAlgorithm algorithm);
     ClippingAlgorithm getClippingAlgorithm() const;
 
+    // Stockage compact (quantifié) des points de contrôle pour les scènes en lecture seule.
+    // Toute modification de la courbe la repasse automatiquement en stockage flottant.
+    void setCompactStorage(bool enabled);
+    bool isCompactStorage() const;
+    float getQuantizationError() const;
+    size_t getMemoryUsage() const;
+
     // Add these getter methods:
-    const std::vector<Point>& getDirectMethodPoints() const { return directMethodPoints; }
-    const std::vector<Point>& getDeCasteljauPoints() const { return deCasteljauPoints; }
+    // Points dans le repère local de la courbe (voir getTransform / bakeTransform)
+    std::span<const Point> getDirectMethodPoints() const { return directMethodPoints; }
+    std::span<const Point> getDeCasteljauPoints() const { return deCasteljauPoints; }
 
 private:
+    // Échantillons hiérarchiques : t = i / 2^level, i = 0..2^level.
+    // Un niveau plus fin ajoute uniquement les indices impairs, un niveau
+    // plus grossier est une vue à pas constant sur les échantillons existants.
+    struct DyadicSamples {
+        PointArray points;
+        int level = -1; // -1 : aucun échantillon valide
+    };
+
+    static constexpr int MIN_STEP_LEVEL = 4;  // pas = 1/16
+    static constexpr int MAX_STEP_LEVEL = 10; // pas = 1/1024
+
     // Points de contrôle et points de la courbe
-    std::vector<Point> controlPoints;
-    std::vector<Point> directMethodPoints;
-    std::vector<Point> deCasteljauPoints;
+    PointArray controlPoints;
+    CompactControlPoints compactControlPoints;
+    bool compactStorage;
+    PointArray directMethodPoints;
+    PointArray deCasteljauPoints;
     ClippingAlgorithm clippingAlgorithm;
+    // Transformation affine appliquée au dessin (repère du groupe parent)
+    Affine2D transform;
+    Affine2D parentTransform;
     // Triangle de Pascal pour les calculs de combinaisons
     std::vector<std::vector<int>> pascalTriangle;
 
+    // Caches d'échantillons pour chaque méthode
+    DyadicSamples directMethodSamples;
+    DyadicSamples deCasteljauSamples;
+
     // Paramètres
-    float step;
+    int stepLevel;
     bool showDirectMethod;
     bool showDeCasteljau;
 
@@ -101,15 +208,85 @@ private:
     GLuint directMethodVAO, directMethodVBO;
     GLuint deCasteljauVAO, deCasteljauVBO;
     GLuint pointsVAO, pointsVBO;
+    // Résultat du découpage : un buffer persistant, agrandi au besoin, dessiné en un appel
+    GLuint clippedVAO, clippedVBO;
+    size_t clippedBufferCapacity; // en sommets
+    ClippedPolylines clippedPolylines;
+    // Clé et nature du résultat actuellement présent dans clippedVBO
+    enum class ClipResult {
+        EMPTY,      // rien de la courbe n'est visible dans la fenêtre
+        POLYLINES,  // tracés d'une courbe ouverte (repère local), dessinés en plus de la courbe
+        POLYGON,    // polygone Sutherland-Hodgman (repère de la scène), remplace la courbe
+        CONTOURS,   // contours Greiner-Hormann (repère local, règle pair-impair), remplacent la courbe
+        UNCLIPPED   // découpage impossible : la courbe est dessinée normalement
+    };
+    struct ClipCache {
+        uint64_t curveVersion = 0;
+        uint64_t windowVersion = 0; // 0 : cache invalide (les fenêtres commencent à 1)
+        ClippingAlgorithm algorithm = ClippingAlgorithm::CYRUS_BECK;
+        ClipResult result = ClipResult::UNCLIPPED;
+        GLsizei polygonVertexCount = 0;
+    };
+    ClipCache clipCache;
+    GLsizei directMethodVertexCount, deCasteljauVertexCount;
+    bool pendingUpdate; // échantillons / buffers à mettre à jour avant le prochain dessin
+    uint64_t version;   // voir getVersion
+    CurveChangeLog* changeLog;
+    uint32_t changeSlot;
+    // Enveloppe convexe des points de contrôle (repère local, sens trigonométrique)
+    mutable std::vector<Point> hull;
+    mutable bool hullValid;
+    // Boucles (repère local), invalidées avec les échantillons
+    mutable std::vector<SelfIntersection> selfIntersections;
+    mutable bool selfIntersectionsValid;
+    // Tessellation (repère local) et hiérarchie de ses segments pour pick(), invalidées avec les échantillons
+    mutable std::vector<Point> segmentPoints;
+    mutable DynamicAABBTree segmentTree{0.0f};
+    mutable bool segmentTreeValid;
 
     // Méthodes internes
+    void swap(BezierCurve& other) noexcept;
+    void bumpVersion();
     void setupBuffers();
     void updateBuffers();
+    void uploadClipped(const std::vector<Point>& vertices);
+    bool isClipCacheValid(const ClipWindow& clipWindow) const;
+    std::span<const Point> pointsForClipping();
+    ClipResult storeClippedPolygon(const std::vector<Point>& clippedPolygon);
+    void storeClipResult(const ClipWindow& clipWindow, ClipResult result, GLsizei polygonVertexCount);
+    ClipResult updateClipCache(const ClipWindow& clipWindow);
+    void drawClippedPolygon(GLShader& shader, GLsizei vertexCount);
+    void drawClippedContours(GLShader& shader);
     void generatePascalTriangle(int n);
     int binomialCoeff(int n, int k);
 
-    // Méthode de Jarvis pour l'enveloppe convexe
-    int orientation(const Point& p, const Point& q, const Point& r) const;
+    // Évaluation d'un point de la courbe pour un paramètre t
+    Point evaluateDirect(float t);
+    Point evaluateDeCasteljau(float t, std::vector<Point>& temp) const;
+
+    // Gestion des échantillons dyadiques
+    template <typename Evaluator>
+    int refineSamples(DyadicSamples& samples, int level, Evaluator evaluate);
+    static void extractLevel(const DyadicSamples& samples, int level, PointArray& out);
+    void invalidateSamples();
+
+    // Transformation affine
+    Point computeCentroid() const;
+    Point toLocal(const Point& world) const;
+    std::vector<Point> worldControlPoints() const;
+    ClipWindow localClipWindow(const ClipWindow& clipWindow) const;
+    static void setModelMatrix(GLShader& shader, const Affine2D& m);
+
+    // Stockage compact
+    void ensureEditable();
+    std::span<const Point> controlPointsView(std::vector<Point>& scratch) const;
+
+    // Enveloppe convexe (chaîne monotone d'Andrew, O(n log n)) et maintenance incrémentale
+    static std::vector<Point> monotoneChainHull(std::vector<Point> points);
+    void buildSegmentTree() const;
+    const std::vector<Point>& localConvexHull() const;
+    bool isHullVertex(const Point& p) const;
+    void updateHullWithPoint(const Point& p);
 };
 
 #endif // BEZIER_CURVE_H
\ No newline at end of file
@@ -0,0 +1,67 @@
+﻿#ifndef BEZIER_INTERSECTION_H
+#define BEZIER_INTERSECTION_H
+
+#include <vector>
+#include "../commons/Point.h"
+#include "../commons/AABB.h"
+
+// Point d'intersection entre deux courbes de Bézier : paramètres sur chaque courbe et position
+struct CurveIntersection {
+    float t1;
+    float t2;
+    Point point;
+};
+
+// Boucle d'une courbe : la courbe repasse au même point pour tStart et tEnd
+struct SelfIntersection {
+    float tStart;
+    float tEnd;
+    Point point;
+};
+
+// Intersection exacte de deux courbes de Bézier (degrés quelconques) par découpage de Bézier
+// (Sederberg-Nishita) : chaque courbe est réduite à l'intervalle de paramètres où l'enveloppe
+// de sa fonction distance coupe la « bande épaisse » de l'autre courbe. La convergence est
+// quadratique pour les intersections transverses ; si un découpage réduit peu l'intervalle,
+// la courbe la plus longue est subdivisée en deux.
+class BezierIntersection {
+public:
+    // tolerance : largeur maximale des intervalles de paramètres retournés
+    static std::vector<CurveIntersection> intersect(const std::vector<Point>& curve1,
+                                                    const std::vector<Point>& curve2,
+                                                    float tolerance = 1e-5f);
+
+    // Auto-intersections : la courbe est subdivisée en morceaux simples (polygone de contrôle
+    // tournant de moins d'un demi-tour, donc sans boucle), puis les paires de morceaux dont les
+    // boîtes se chevauchent sont découpées comme deux courbes distinctes
+    static std::vector<SelfIntersection> selfIntersect(const std::vector<Point>& curve,
+                                                       float tolerance = 1e-5f);
+
+    // Sous-courbe correspondant à l'intervalle de paramètres [t0, t1] (De Casteljau)
+    static std::vector<Point> subCurve(const std::vector<Point>& curve, float t0, float t1);
+    static Point evaluate(const std::vector<Point>& curve, float t);
+
+private:
+    struct Interval {
+        float start, end; // paramètres sur la courbe d'origine
+    };
+
+    struct Piece {
+        std::vector<Point> points;
+        Interval range;
+        AABB box;
+    };
+
+    static void splitIntoSimplePieces(const std::vector<Point>& curve, Interval range, int depth,
+                                      std::vector<Piece>& out);
+    static float controlPolygonTurning(const std::vector<Point>& curve);
+    static void clip(const std::vector<Point>& p, Interval pRange,
+                     const std::vector<Point>& q, Interval qRange,
+                     bool swapped, int depth, float tolerance, std::vector<CurveIntersection>& out);
+    static bool clipToFatLine(const std::vector<Point>& p, const std::vector<Point>& q,
+                              float& tMin, float& tMax);
+    static void split(const std::vector<Point>& curve, float t,
+                      std::vector<Point>& left, std::vector<Point>& right);
+};
+
+#endif // BEZIER_INTERSECTION_H
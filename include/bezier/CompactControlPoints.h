@@ -0,0 +1,70 @@
+﻿#ifndef COMPACT_CONTROL_POINTS_H
+#define COMPACT_CONTROL_POINTS_H
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include "../commons/Point.h"
+
+// Stockage compact des points de contrôle d'une courbe :
+// - quantification sur 16 bits relative à la boîte englobante de la courbe
+// - codage des écarts entre points successifs (zigzag + entiers de longueur variable)
+// - un point absolu tous les BLOCK_SIZE points pour garder un accès aléatoire rapide
+class CompactControlPoints {
+public:
+    CompactControlPoints();
+
+    void encode(std::span<const Point> points);
+    // out : std::vector<Point> ou PointArray
+    template <typename Points>
+    void decode(Points& out) const {
+        out.resize(count);
+        Reader r(*this);
+        for (int i = 0; i < count; i++) {
+            out[i] = r.next();
+        }
+    }
+    void clear();
+
+    Point at(int index) const;
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Erreur maximale (distance) mesurée entre les points d'origine et les points décodés
+    float getMaxError() const { return maxError; }
+    size_t memoryUsage() const;
+
+    // Lecture séquentielle, utilisée directement par les noyaux d'évaluation
+    class Reader {
+    public:
+        explicit Reader(const CompactControlPoints& storage);
+        Point next();
+
+    private:
+        const CompactControlPoints& storage;
+        size_t offset;
+        int index;
+        int32_t qx, qy;
+    };
+
+    Reader reader() const { return Reader(*this); }
+
+private:
+    static constexpr int BLOCK_SIZE = 32;
+
+    Point origin;
+    float scaleX, scaleY; // taille d'un pas de quantification
+    int count;
+    float maxError;
+    std::vector<uint8_t> data;
+    std::vector<uint32_t> blockOffsets;
+
+    Point dequantize(int32_t qx, int32_t qy) const;
+    static void writeVarint(std::vector<uint8_t>& out, uint32_t value);
+    static uint32_t readVarint(const std::vector<uint8_t>& in, size_t& offset);
+    static uint32_t zigzag(int32_t value);
+    static int32_t unzigzag(uint32_t value);
+};
+
+#endif // COMPACT_CONTROL_POINTS_H
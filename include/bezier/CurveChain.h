@@ -0,0 +1,44 @@
+﻿#ifndef CURVE_CHAIN_H
+#define CURVE_CHAIN_H
+
+#include <vector>
+#include "BezierCurve.h"
+
+// Chaîne ordonnée de courbes raccordées bout à bout (fin de la courbe i = début de la courbe i+1).
+// enforce() impose la continuité choisie sur toutes les jonctions en une passe, dans le repère
+// de la scène, et ne marque pour recalcul (différé) que les courbes réellement modifiées.
+class CurveChain {
+public:
+    enum class Continuity {
+        C0 = 0, // positions
+        C1 = 1, // dérivées premières (tenant compte des degrés)
+        G1 = 2, // tangentes colinéaires, longueurs conservées
+        C2 = 3  // dérivées secondes
+    };
+
+    explicit CurveChain(std::vector<BezierCurve*> curves);
+
+    // Retourne le nombre de courbes modifiées
+    int enforce(Continuity continuity);
+
+    // Première courbe fixe : seules les suivantes sont ajustées (raccordement de proche en proche,
+    // sans résolution globale en C2)
+    void setFirstCurveFixed(bool fixed) { firstCurveFixed = fixed; }
+
+    static const char* getContinuityName(Continuity continuity);
+
+private:
+    std::vector<BezierCurve*> curves;
+    std::vector<std::vector<Point>> points; // points de contrôle (scène) de chaque courbe
+    std::vector<bool> changed;
+    bool firstCurveFixed = false;
+
+    void setPoint(int curve, int index, const Point& p);
+    void enforceC0();
+    void enforceTangents(bool matchMagnitude);
+    void enforceTangentAt(int joint, bool matchMagnitude);
+    void enforceC2();
+    bool solveCubicSpline();
+};
+
+#endif // CURVE_CHAIN_H
@@ -0,0 +1,34 @@
+﻿#ifndef CURVE_CHANGE_LOG_H
+#define CURVE_CHANGE_LOG_H
+
+#include <vector>
+#include <cstdint>
+
+// Emplacements du CurveStore dont la courbe a été créée, modifiée (nouvelle version) ou
+// supprimée depuis la dernière lecture. Chaque emplacement n'y figure qu'une fois : les index
+// (arbre des boîtes, grille des points) ne réajustent que ces courbes.
+struct CurveChangeLog {
+    std::vector<uint32_t> slots;
+    std::vector<uint8_t> queued; // par emplacement : déjà présent dans slots
+
+    void mark(uint32_t slot) {
+        if (slot >= queued.size()) {
+            queued.resize(slot + 1, 0);
+        }
+        if (!queued[slot]) {
+            queued[slot] = 1;
+            slots.push_back(slot);
+        }
+    }
+
+    // Vide le journal dans out (remplacé)
+    void take(std::vector<uint32_t>& out) {
+        out.clear();
+        out.swap(slots);
+        for (uint32_t slot : out) {
+            queued[slot] = 0;
+        }
+    }
+};
+
+#endif // CURVE_CHANGE_LOG_H
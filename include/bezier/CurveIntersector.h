@@ -0,0 +1,57 @@
+﻿#ifndef CURVE_INTERSECTOR_H
+#define CURVE_INTERSECTOR_H
+
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include "CurveStore.h"
+#include "../commons/AABB.h"
+
+// Détection de toutes les paires de courbes de la scène dont les enveloppes convexes se coupent :
+// - phase large : balayage et élagage (sweep and prune) des boîtes englobantes triées en x ;
+// - phase fine : test des enveloppes convexes des paires candidates, réparti sur plusieurs threads ;
+//   l'axe séparateur de chaque paire est gardé d'un appel à l'autre (cohérence temporelle).
+// Les enveloppes et boîtes sont calculées une seule fois par courbe, dans le repère de la scène.
+class CurveIntersector {
+public:
+    struct Stats {
+        size_t curveCount = 0;
+        size_t candidatePairs = 0;   // paires dont les boîtes se chevauchent
+        size_t intersectingPairs = 0;
+        size_t cachedAxes = 0;       // paires testées d'abord sur l'axe séparateur précédent
+        int threadCount = 0;
+        double prepareMs = 0.0;      // enveloppes et boîtes
+        double broadPhaseMs = 0.0;
+        double narrowPhaseMs = 0.0;
+        double totalMs() const { return prepareMs + broadPhaseMs + narrowPhaseMs; }
+    };
+
+    using CurvePair = std::pair<CurveHandle, CurveHandle>;
+
+    // 0 : nombre de cœurs disponibles
+    void setThreadCount(int count) { threadCount = count; }
+
+    std::vector<CurvePair> findAllPairs(const CurveStore& curves);
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Entry {
+        AABB box;
+        uint32_t curve; // index dense dans le CurveStore
+    };
+
+    int threadCount = 0;
+    Stats stats;
+    std::vector<std::vector<Point>> hulls;
+    std::vector<Entry> entries;
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+    // Axe séparateur de chaque paire séparée lors du dernier appel, par emplacements des handles
+    std::unordered_map<uint64_t, Point> separatingAxes;
+
+    static uint64_t pairKey(CurveHandle a, CurveHandle b);
+
+    int resolveThreadCount(size_t workItems) const;
+    void sweepAndPrune();
+};
+
+#endif // CURVE_INTERSECTOR_H
@@ -0,0 +1,86 @@
+﻿#ifndef CURVE_STORE_H
+#define CURVE_STORE_H
+
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include "BezierCurve.h"
+#include "CurveChangeLog.h"
+
+// Poignée stable vers une courbe du CurveStore.
+// La génération invalide les poignées vers un emplacement libéré puis réutilisé.
+struct CurveHandle {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool operator==(const CurveHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const CurveHandle& other) const { return !(*this == other); }
+};
+
+// Stockage contigu des courbes :
+// - les courbes sont rangées de façon dense dans un std::vector (parcours linéaire) ;
+// - les poignées passent par une table d'emplacements (index dense + génération) ;
+// - les emplacements libérés sont réutilisés via une liste libre ;
+// - les points de contrôle de toutes les courbes sont alloués dans une arène, leurs échantillons
+//   dans une autre : de grands blocs contigus découpés par classe de taille, dont les morceaux
+//   libérés sont réutilisés par la courbe suivante.
+// Les courbes gardent leur ordre de création ; un ajout ou une suppression peut déplacer
+// les courbes en mémoire : seules les poignées sont stables, pas les pointeurs.
+// Les arènes ne sont pas synchronisées : les courbes ne sont modifiées que par le thread principal.
+class CurveStore {
+public:
+    CurveStore();
+    CurveStore(const CurveStore&) = delete;
+    CurveStore& operator=(const CurveStore&) = delete;
+
+    CurveHandle create();
+    // Crée une courbe à la position dense denseIndex (annuler une suppression) ; les suivantes sont décalées
+    CurveHandle create(size_t denseIndex);
+    bool remove(CurveHandle handle);
+    void clear();
+    void reserve(size_t count);
+
+    bool isValid(CurveHandle handle) const;
+    BezierCurve* get(CurveHandle handle);
+    const BezierCurve* get(CurveHandle handle) const;
+
+    // Accès dense
+    size_t size() const { return curves.size(); }
+    bool empty() const { return curves.empty(); }
+    BezierCurve& operator[](size_t denseIndex) { return curves[denseIndex]; }
+    const BezierCurve& operator[](size_t denseIndex) const { return curves[denseIndex]; }
+    CurveHandle handleAt(size_t denseIndex) const;
+    // Poignée de la courbe rangée à cet emplacement, invalide s'il est libre
+    CurveHandle handleOfSlot(uint32_t slot) const;
+    size_t denseIndexOf(CurveHandle handle) const { return slots[handle.index].denseIndex; }
+    CurveHandle handleOf(const BezierCurve* curve) const;
+
+    // Emplacements dont la courbe a été créée, modifiée ou supprimée depuis l'appel précédent
+    void takeChanges(std::vector<uint32_t>& slots) { changes.take(slots); }
+
+    std::vector<BezierCurve>::iterator begin() { return curves.begin(); }
+    std::vector<BezierCurve>::iterator end() { return curves.end(); }
+    std::vector<BezierCurve>::const_iterator begin() const { return curves.begin(); }
+    std::vector<BezierCurve>::const_iterator end() const { return curves.end(); }
+
+private:
+    struct Slot {
+        uint32_t denseIndex; // CurveHandle::INVALID_INDEX si l'emplacement est libre
+        uint32_t generation;
+    };
+
+    // Déclarées avant les courbes, qui leur rendent leur mémoire en étant détruites
+    std::pmr::unsynchronized_pool_resource controlPointArena;
+    std::pmr::unsynchronized_pool_resource sampleArena;
+    std::vector<BezierCurve> curves;     // courbes, rangées de façon contiguë
+    std::vector<uint32_t> denseToSlot;   // emplacement de chaque courbe dense
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    CurveChangeLog changes;
+};
+
+#endif // CURVE_STORE_H
@@ -0,0 +1,127 @@
+﻿#ifndef EDIT_HISTORY_H
+#define EDIT_HISTORY_H
+
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include "../commons/Affine2D.h"
+#include "CurveStore.h"
+#include "SceneGraph.h"
+
+// Historique annuler / rétablir sous forme de journal de commandes :
+// - chaque action ne garde que son écart (point déplacé, inséré ou retiré, matrice appliquée),
+//   jamais une copie de la scène ; annuler ou rétablir coûte O(taille de l'écart) ;
+// - les déplacements successifs d'un même point pendant un glisser sont fusionnés en une entrée ;
+// - la mémoire occupée est bornée : les entrées les plus anciennes sont oubliées au-delà du budget.
+// Une courbe supprimée puis restaurée reprend sa place dans l'ordre des courbes mais reçoit une
+// nouvelle poignée : les entrées désignent les courbes par un identifiant logique, et seule
+// l'entrée de cet identifiant dans la table des poignées change.
+class EditHistory {
+public:
+    explicit EditHistory(size_t memoryBudget = 4 * 1024 * 1024);
+
+    // Glisser d'un point : les déplacements enregistrés entre beginDrag et endDrag sont fusionnés
+    void beginDrag();
+    void endDrag();
+    // Les entrées enregistrées entre beginGroup et endGroup sont annulées et rétablies ensemble
+    void beginGroup();
+    void endGroup();
+
+    // Points en coordonnées de la scène
+    void recordPointMove(CurveHandle curve, int index, const Point& from, const Point& to);
+    void recordPointInsert(CurveHandle curve, int index, const Point& point);
+    void recordPointRemove(CurveHandle curve, int index, const Point& point);
+    // Matrice (repère de la scène) appliquée à certains points d'une courbe ; indices croissants
+    void recordPointsTransform(CurveHandle curve, std::vector<int> indices, const Affine2D& m);
+    // Points retirés d'une courbe : indices croissants dans la courbe d'avant le retrait
+    void recordPointsRemove(CurveHandle curve, std::vector<int> indices, std::vector<Point> points);
+    // Matrice appliquée à chaque courbe dans le repère de son groupe parent (BezierCurve::applyTransform)
+    void recordTransform(const std::vector<CurveHandle>& curves, const Affine2D& m);
+    // Matrice appliquée au groupe dans le repère de son parent (SceneGraph::applyTransform)
+    void recordGroupTransform(SceneGraph::GroupId group, const Affine2D& m);
+    void recordCurveCreate(CurveHandle curve);
+    // À appeler avant la suppression : garde les points, l'état d'affichage et la position de la courbe
+    void recordCurveDelete(CurveHandle curve, const CurveStore& curves, SceneGraph::GroupId group);
+
+    // Retournent false s'il n'y a rien à annuler / rétablir
+    bool undo(CurveStore& curves, SceneGraph& sceneGraph);
+    bool redo(CurveStore& curves, SceneGraph& sceneGraph);
+    bool canUndo() const { return !undoStack.empty(); }
+    bool canRedo() const { return !redoStack.empty(); }
+
+    void clear();
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return memoryBudget; }
+    size_t getMemoryUsage() const { return memoryUsage; }
+    size_t getUndoCount() const { return undoStack.size(); }
+    size_t getRedoCount() const { return redoStack.size(); }
+    // Poignée de la dernière courbe touchée par undo / redo (invalide si aucune)
+    CurveHandle getLastCurve() const { return lastCurve; }
+
+private:
+    enum class Type {
+        MOVE_POINT,
+        INSERT_POINT,
+        REMOVE_POINT,
+        TRANSFORM_POINTS,
+        REMOVE_POINTS,
+        TRANSFORM,
+        GROUP_TRANSFORM,
+        CREATE_CURVE,
+        DELETE_CURVE
+    };
+
+    // Identifiant d'une courbe dans le journal, stable d'une suppression à sa restauration
+    using CurveId = uint32_t;
+    static constexpr CurveId NO_CURVE = UINT32_MAX;
+
+    struct Edit {
+        Type type;
+        CurveId curve = NO_CURVE;
+        int index = -1;                     // *_POINT : indice du point ; *_CURVE : position dense
+        Point from, to;                     // MOVE_POINT ; INSERT/REMOVE_POINT : to
+        Affine2D matrix;                    // TRANSFORM, GROUP_TRANSFORM
+        SceneGraph::GroupId group = SceneGraph::INVALID_GROUP;
+        std::vector<CurveId> curves;        // TRANSFORM
+        std::vector<Point> points;          // DELETE_CURVE, REMOVE_POINTS
+        std::vector<int> indices;           // TRANSFORM_POINTS, REMOVE_POINTS
+        BezierCurve::ClippingAlgorithm clippingAlgorithm = BezierCurve::ClippingAlgorithm::CYRUS_BECK;
+        bool showDirectMethod = false;
+        bool showDeCasteljau = false;
+        bool open = false;                  // glisser en cours
+        bool chained = false;               // fait partie de la même action que l'entrée précédente
+
+        size_t memoryUsage() const;
+    };
+
+    std::deque<Edit> undoStack;
+    std::vector<Edit> redoStack;
+    size_t memoryBudget;
+    size_t memoryUsage;
+    bool dragging;
+    int groupDepth;
+    bool groupHasEntry;
+    CurveHandle lastCurve;
+
+    // Table des identifiants : poignée actuelle de chaque identifiant, et identifiant de la
+    // courbe rangée à chaque emplacement du CurveStore (valable pour sa génération)
+    struct SlotCurve {
+        uint32_t generation = 0;
+        CurveId id = NO_CURVE;
+    };
+    std::vector<CurveHandle> curveHandles;
+    std::vector<SlotCurve> slotCurves;
+
+    void push(Edit&& edit);
+    void enforceBudget();
+    // Applique (forward) ou annule (!forward) une entrée ; false si ses courbes n'existent plus
+    bool apply(Edit& edit, bool forward, CurveStore& curves, SceneGraph& sceneGraph);
+    void removeCurve(Edit& edit, CurveStore& curves, SceneGraph& sceneGraph);
+    void restoreCurve(Edit& edit, CurveStore& curves, SceneGraph& sceneGraph);
+    CurveId curveId(CurveHandle handle);
+    CurveHandle handleOf(CurveId id) const { return id != NO_CURVE ? curveHandles[id] : CurveHandle(); }
+    void bindCurve(CurveId id, CurveHandle handle);
+};
+
+#endif // EDIT_HISTORY_H
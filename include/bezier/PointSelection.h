@@ -0,0 +1,47 @@
+﻿#ifndef POINT_SELECTION_H
+#define POINT_SELECTION_H
+
+#include <vector>
+#include <cstdint>
+#include "CurveStore.h"
+
+// Sélection de points de contrôle sur plusieurs courbes : un champ de bits par courbe
+// (un bit par point), rangé par emplacement du CurveStore. Une courbe supprimée ou dont
+// l'emplacement est réutilisé est ignorée grâce à la génération de sa poignée.
+class PointSelection {
+public:
+    void clear();
+    bool empty() const { return total == 0; }
+    size_t count() const { return total; }
+
+    void select(CurveHandle curve, int index, bool selected = true);
+    // Sélectionne les points [0, count[ de la courbe
+    void selectAll(CurveHandle curve, int count);
+    bool isSelected(CurveHandle curve, int index) const;
+    size_t count(CurveHandle curve) const;
+
+    // Courbes ayant au moins un point sélectionné
+    std::vector<CurveHandle> getCurves() const;
+    // Indices sélectionnés d'une courbe, croissants (parcours des mots non nuls)
+    std::vector<int> getIndices(CurveHandle curve) const;
+
+    // Retire les courbes supprimées et les bits au-delà du nombre de points de chaque courbe
+    void prune(const CurveStore& curves);
+    size_t memoryUsage() const;
+
+private:
+    struct CurveBits {
+        uint32_t generation = 0;
+        size_t count = 0;
+        std::vector<uint64_t> words;
+    };
+
+    std::vector<CurveBits> curves; // par emplacement
+    size_t total = 0;
+
+    CurveBits* find(CurveHandle curve);
+    const CurveBits* find(CurveHandle curve) const;
+    CurveBits& acquire(CurveHandle curve);
+};
+
+#endif // POINT_SELECTION_H
@@ -0,0 +1,83 @@
+﻿#ifndef SCENE_GRAPH_H
+#define SCENE_GRAPH_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "../commons/Affine2D.h"
+#include "CurveStore.h"
+
+// Graphe de scène : groupes imbriqués de courbes avec transformation locale.
+// La matrice monde de chaque groupe est mise en cache ; modifier un groupe le marque
+// « sale » et update() ne recalcule que les sous-arbres concernés avant de transmettre
+// les matrices aux courbes (BezierCurve::setParentTransform).
+class SceneGraph {
+public:
+    using GroupId = int;
+    static constexpr GroupId ROOT = 0;
+    static constexpr GroupId INVALID_GROUP = -1;
+
+    SceneGraph();
+
+    GroupId createGroup(GroupId parent = ROOT, const std::string& name = "");
+    // Les enfants et les courbes du groupe supprimé sont rattachés à son parent
+    void removeGroup(GroupId group, CurveStore& curves);
+    void clear();
+
+    bool isValid(GroupId group) const;
+    GroupId getParent(GroupId group) const;
+    const std::vector<GroupId>& getChildren(GroupId group) const;
+    const std::vector<CurveHandle>& getCurves(GroupId group) const;
+    const std::string& getName(GroupId group) const;
+    size_t getGroupCount() const;
+
+    // Rattache une courbe à un groupe sans modifier sa position dans la scène
+    void addCurve(GroupId group, CurveHandle curve, CurveStore& curves);
+    void removeCurve(CurveHandle curve);
+    GroupId groupOf(CurveHandle curve) const;
+
+    // Transformations locales (repère du groupe parent)
+    void setLocalTransform(GroupId group, const Affine2D& m);
+    const Affine2D& getLocalTransform(GroupId group) const;
+    void applyTransform(GroupId group, const Affine2D& m);      // m dans le repère du parent
+    void applyWorldTransform(GroupId group, const Affine2D& m); // m dans le repère de la scène
+
+    // Matrice monde en cache (valide après update())
+    const Affine2D& getWorldTransform(GroupId group) const;
+    // Boîte englobante (dans la scène) des courbes du sous-arbre, false s'il est vide
+    bool getBounds(GroupId group, const CurveStore& curves, Point& minPoint, Point& maxPoint) const;
+
+    // Recalcule les sous-arbres modifiés et met à jour les courbes concernées.
+    // Retourne le nombre de groupes recalculés.
+    int update(CurveStore& curves);
+
+private:
+    struct Group {
+        std::string name;
+        GroupId parent = INVALID_GROUP;
+        int depth = 0;
+        std::vector<GroupId> children;
+        std::vector<CurveHandle> curves;
+        Affine2D local;
+        Affine2D world;
+        bool dirty = false;
+        bool alive = false;
+    };
+
+    std::vector<Group> groups;
+    std::vector<GroupId> freeGroups;
+    std::vector<GroupId> dirtyGroups;
+    // Index de poignée -> groupe. La génération est gardée comme dans CurveStore : une fois
+    // l'emplacement réutilisé, la nouvelle courbe n'hérite pas du groupe de l'ancienne.
+    struct CurveEntry {
+        uint32_t generation;
+        GroupId group;
+    };
+    std::unordered_map<uint32_t, CurveEntry> curveGroups;
+
+    void markDirty(GroupId group);
+    void updateSubtree(GroupId group, CurveStore& curves, int& updated);
+    void setDepth(GroupId group, int depth);
+};
+
+#endif // SCENE_GRAPH_H
@@ -0,0 +1,75 @@
+﻿#ifndef SNAP_ENGINE_H
+#define SNAP_ENGINE_H
+
+#include <array>
+#include <functional>
+#include "../commons/Point.h"
+#include "CurveStore.h"
+
+// Aimantation du curseur sur des cibles de la scène (grille, points de contrôle, courbes,
+// fenêtre de découpage). Chaque type de cible est interrogé par un fournisseur, branché sur
+// l'index spatial correspondant par l'application. Les types sont essayés par ordre de
+// priorité : la première cible trouvée dans le rayon l'emporte, même si une cible moins
+// prioritaire est plus proche.
+class SnapEngine {
+public:
+    enum class Target {
+        CONTROL_POINT,
+        CLIP_VERTEX,
+        CURVE,
+        CLIP_EDGE,
+        GRID,
+        COUNT
+    };
+    static constexpr int TARGET_COUNT = static_cast<int>(Target::COUNT);
+
+    struct Snap {
+        Target target = Target::GRID;
+        Point point;
+        float distance = 0.0f;
+        CurveHandle curve; // CONTROL_POINT, CURVE
+        int index = -1;    // indice du point, du sommet ou de l'arête
+        float t = 0.0f;    // CURVE : paramètre ; CLIP_EDGE : position sur l'arête
+    };
+
+    // Retourne le candidat le plus proche de p à moins de radius (distance remplie par l'engine)
+    using Provider = std::function<bool(const Point& p, float radius, Snap& snap)>;
+
+    SnapEngine();
+
+    void setProvider(Target target, Provider provider);
+
+    bool isEnabled() const { return enabled; }
+    void setEnabled(bool value) { enabled = value; }
+    bool isTargetEnabled(Target target) const { return targetEnabled[index(target)]; }
+    void setTargetEnabled(Target target, bool value) { targetEnabled[index(target)] = value; }
+    // Plus petite valeur = plus prioritaire
+    int getPriority(Target target) const { return priority[index(target)]; }
+    void setPriority(Target target, int value);
+
+    float getRadius() const { return radius; }
+    void setRadius(float value) { radius = value; }
+    float getGridSpacing() const { return gridSpacing; }
+    void setGridSpacing(float value) { gridSpacing = value; }
+
+    bool snap(const Point& p, Snap& result);
+    double getLastQueryMs() const { return lastQueryMs; }
+
+    static const char* getTargetName(Target target);
+
+private:
+    bool enabled;
+    float radius;
+    float gridSpacing;
+    std::array<bool, TARGET_COUNT> targetEnabled;
+    std::array<int, TARGET_COUNT> priority;
+    std::array<Target, TARGET_COUNT> order; // types triés par priorité
+    std::array<Provider, TARGET_COUNT> providers;
+    double lastQueryMs;
+
+    static int index(Target target) { return static_cast<int>(target); }
+    void sortTargets();
+    bool snapToGrid(const Point& p, Snap& result) const;
+};
+
+#endif // SNAP_ENGINE_H
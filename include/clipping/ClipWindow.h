@@ -0,0 +1,61 @@
+﻿#ifndef CLIP_WINDOW_H
+#define CLIP_WINDOW_H
+
+#include <vector>
+#include <cstdint>
+#include "../commons/Point.h"
+#include "../commons/AABB.h"
+#include "../commons/Affine2D.h"
+
+// Fenêtre de découpage : ses sommets et les données qu'en tirent les algorithmes de découpage
+// (convexité, sens de parcours, boîte englobante, normales et décalages des arêtes). Ces données
+// sont recalculées à chaque modification seulement ; une fenêtre inchangée ne coûte rien par image.
+class ClipWindow {
+public:
+    ClipWindow();
+    explicit ClipWindow(std::vector<Point> vertices);
+
+    // Édition : chaque modification recalcule les données dérivées et change la version
+    void addVertex(const Point& p);
+    void moveVertex(int index, const Point& p);
+    void removeVertex(int index);
+    void clear();
+
+    // Image de la fenêtre par une transformation affine ; le sens de parcours est conservé
+    // (une symétrie le rétablit) et la version reste celle de cette fenêtre
+    ClipWindow transformed(const Affine2D& m) const;
+
+    const std::vector<Point>& getVertices() const { return vertices; }
+    const Point& operator[](size_t index) const { return vertices[index]; }
+    size_t size() const { return vertices.size(); }
+    bool empty() const { return vertices.empty(); }
+
+    // Identifiant de l'état courant, unique entre toutes les fenêtres : clé des caches de découpage
+    uint64_t getVersion() const { return version; }
+
+    bool isConvex() const { return convex; }
+    bool isCounterClockwise() const { return counterClockwise; }
+    const AABB& getBounds() const { return bounds; }
+
+    // Arêtes non dégénérées : normales unitaires sortantes et décalages. Un point p est du côté
+    // intérieur de l'arête j si normalX[j] * p.x + normalY[j] * p.y <= offset[j], quel que soit
+    // le sens de parcours de la fenêtre.
+    size_t edgeCount() const { return offsets.size(); }
+    const std::vector<float>& getNormalX() const { return normalX; }
+    const std::vector<float>& getNormalY() const { return normalY; }
+    const std::vector<float>& getOffsets() const { return offsets; }
+
+private:
+    std::vector<Point> vertices;
+    uint64_t version;
+
+    // Données dérivées
+    bool convex;
+    bool counterClockwise;
+    AABB bounds;
+    std::vector<float> normalX, normalY, offsets;
+
+    void rebuild();
+};
+
+#endif // CLIP_WINDOW_H
@@ -0,0 +1,47 @@
+﻿#ifndef CLIPPED_POLYLINES_H
+#define CLIPPED_POLYLINES_H
+
+#include <vector>
+#include "../commons/Point.h"
+
+// Résultat d'un découpage : des tracés continus (polylignes) rangés bout à bout dans un seul
+// tableau de sommets. Le tracé i occupe vertices[first[i] .. first[i] + count[i][ ; first et
+// count ont directement le format attendu par glMultiDrawArrays.
+struct ClippedPolylines {
+    std::vector<Point> vertices;
+    std::vector<int> first;
+    std::vector<int> count;
+
+    // Garde les capacités : un découpage répété n'alloue plus
+    void clear() {
+        vertices.clear();
+        first.clear();
+        count.clear();
+    }
+
+    bool empty() const { return first.empty(); }
+    size_t runCount() const { return first.size(); }
+
+    void beginRun(const Point& p) {
+        first.push_back(static_cast<int>(vertices.size()));
+        count.push_back(1);
+        vertices.push_back(p);
+    }
+
+    void extendRun(const Point& p) {
+        vertices.push_back(p);
+        count.back()++;
+    }
+
+    // Un tableau par tracé
+    std::vector<std::vector<Point>> toRuns() const {
+        std::vector<std::vector<Point>> runs;
+        runs.reserve(first.size());
+        for (size_t i = 0; i < first.size(); i++) {
+            runs.emplace_back(vertices.begin() + first[i], vertices.begin() + first[i] + count[i]);
+        }
+        return runs;
+    }
+};
+
+#endif // CLIPPED_POLYLINES_H
@@ -1,23 +1,33 @@
 ﻿#pragma once
 #include <vector>
+#include <span>
 #include "../commons/Point.h"
+#include "ClipWindow.h"
+#include "ClippedPolylines.h"
 
 class CyrusBeck {
 public:
+    // Nombre de segments traités ensemble par le découpage par lots
+    static constexpr int LANES = 8;
+
     // Vérifie si un polygone est convexe
     static bool isPolygonConvex(const std::vector<Point>& polygon);
-    
-    // Découpe une courbe (représentée comme une série de points) selon une fenêtre de découpage
+
+    // Découpe une courbe (représentée comme une série de points) selon une fenêtre de découpage ;
+    // un tableau par tracé continu
     static std::vector<std::vector<Point>> clipCurveToWindow(const std::vector<Point>& curve, const std::vector<Point>& clipWindow);
-    
+
+    // Découpage par lots : les segments sont chargés par blocs de LANES en structure de tableaux
+    // et tE / tL sont calculés pour tout le bloc à la fois (SSE2 quand il est disponible). Un bloc
+    // entièrement dedans ou dehors est classé par sa boîte, et le calcul s'arrête dès que tous
+    // ses segments sont rejetés. Deux segments consécutifs dont le sommet commun reste visible
+    // prolongent le même tracé de out (qui n'est pas vidé). Une fenêtre non convexe ne produit rien.
+    static void clipPolyline(std::span<const Point> curve, const ClipWindow& window, ClippedPolylines& out);
+
 private:
     // Calcule le produit vectoriel 2D
     static float crossProduct(const Point& a, const Point& b);
     
     // Calcule le produit scalaire 2D
     static float dotProduct(const Point& a, const Point& b);
-    
-    // Vérifie si un segment de ligne (p1, p2) intersecte une arête de la fenêtre (e1, e2)
-    static bool clipSegmentToEdge(const Point& p1, const Point& p2, const Point& e1, const Point& e2,
-                                 float& tE, float& tL, Point& normal);
 };
\ No newline at end of file
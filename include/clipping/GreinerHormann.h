@@ -0,0 +1,25 @@
+﻿#pragma once
+#include <vector>
+#include <span>
+#include "../commons/Point.h"
+#include "ClipWindow.h"
+#include "ClippedPolylines.h"
+
+// Découpage par une fenêtre quelconque : concave, auto-intersectante ou à trous. La région est
+// définie par la règle pair-impair : un point est dedans s'il est entouré par un nombre impair
+// de contours. Les arêtes de la fenêtre sont rangées dans un arbre de boîtes et chaque segment
+// ne teste que celles qu'il peut couper : O((n + k) log m) pour n segments, m arêtes et
+// k intersections.
+class GreinerHormann {
+public:
+    using Contours = std::vector<std::vector<Point>>;
+
+    // Polyligne ouverte : les tracés visibles sont ajoutés à out (qui n'est pas vidé)
+    static void clipPolyline(std::span<const Point> curve, const Contours& window, ClippedPolylines& out);
+    static void clipPolyline(std::span<const Point> curve, const ClipWindow& window, ClippedPolylines& out);
+
+    // Intersection de deux régions (algorithme de Greiner-Hormann). Le résultat est un ensemble
+    // de contours, à lire lui aussi avec la règle pair-impair (trous compris).
+    static Contours clipPolygon(const Contours& subject, const Contours& window);
+    static Contours clipPolygon(std::span<const Point> subject, const ClipWindow& window);
+};
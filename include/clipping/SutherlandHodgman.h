@@ -1,19 +1,44 @@
 ﻿#pragma once
 #include <vector>
+#include <span>
 #include "../commons/Point.h"
+#include "../commons/Affine2D.h"
+#include "ClipWindow.h"
 
 class SutherlandHodgman {
 public:
+    // Tampons de travail d'un découpage, gardés d'un appel à l'autre (un par thread) : les deux
+    // tampons alternent d'une arête de la fenêtre à la suivante, et une fois à leur taille,
+    // découper n'alloue plus
+    struct Scratch {
+        std::vector<Point> buffers[2];
+        std::vector<Point> subject; // sujet ramené dans le repère de la fenêtre (découpage par lots)
+    };
+
+    // Polygone d'un découpage par lots, et la transformation qui l'amène dans le repère de la fenêtre
+    struct Subject {
+        std::span<const Point> points;
+        Affine2D transform;
+    };
+
     // Découpe un polygone en utilisant un autre polygone comme fenêtre de découpage
     static std::vector<Point> clipPolygon(const std::vector<Point>& subjectPolygon, const std::vector<Point>& clipPolygon);
+    // Même découpage avec les normales et décalages déjà calculés par la fenêtre (convexe,
+    // parcourue dans un sens quelconque)
+    static std::vector<Point> clipPolygon(std::span<const Point> subjectPolygon, const ClipWindow& window);
+    // Sans copie du sujet ni allocation : le résultat est l'un des tampons de scratch, valable
+    // jusqu'au découpage suivant avec le même scratch
+    static const std::vector<Point>& clipPolygon(std::span<const Point> subjectPolygon, const ClipWindow& window,
+                                                 Scratch& scratch);
+
+    // Découpe de nombreux polygones fermés par la même fenêtre, répartis sur threadCount threads
+    // (0 : nombre de cœurs). arenas fournit un Scratch par thread et se garde d'un appel à l'autre ;
+    // results[i] reçoit le découpage de subjects[i], dans le repère de la fenêtre.
+    static void clipPolygons(const std::vector<Subject>& subjects, const ClipWindow& window,
+                             std::vector<std::vector<Point>>& results, std::vector<Scratch>& arenas,
+                             int threadCount = 0);
 
     // Fonction optionnelle pour adapter l'algorithme aux courbes ouvertes
     static std::vector<std::vector<Point>> clipCurve(const std::vector<Point>& curve, const std::vector<Point>& clipPolygon);
-
-private:
-    // Vérifie si un point est à l'intérieur d'une arête
-    static bool isInside(const Point& p, const Point& p1, const Point& p2);
-
-    // Calcule l'intersection entre un segment et une arête
-    static Point computeIntersection(const Point& s, const Point& e, const Point& p1, const Point& p2);
+    static std::vector<std::vector<Point>> clipCurve(const std::vector<Point>& curve, const ClipWindow& window);
 };
\ No newline at end of file
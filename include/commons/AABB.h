@@ -0,0 +1,89 @@
+﻿#ifndef AABB_H
+#define AABB_H
+
+#include <vector>
+#include <algorithm>
+#include "Point.h"
+
+// Boîte englobante alignée sur les axes
+struct AABB {
+    Point min, max;
+
+    AABB() = default;
+    AABB(const Point& min, const Point& max) : min(min), max(max) {}
+
+    static AABB fromPoints(const std::vector<Point>& points) {
+        AABB box(points.empty() ? Point() : points[0], points.empty() ? Point() : points[0]);
+        for (const Point& p : points) {
+            box.min.x = std::min(box.min.x, p.x);
+            box.min.y = std::min(box.min.y, p.y);
+            box.max.x = std::max(box.max.x, p.x);
+            box.max.y = std::max(box.max.y, p.y);
+        }
+        return box;
+    }
+
+    bool contains(const Point& p) const {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    }
+
+    bool contains(const AABB& other) const {
+        return other.min.x >= min.x && other.min.y >= min.y &&
+               other.max.x <= max.x && other.max.y <= max.y;
+    }
+
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+               min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    AABB merged(const AABB& other) const {
+        return AABB(Point(std::min(min.x, other.min.x), std::min(min.y, other.min.y)),
+                    Point(std::max(max.x, other.max.x), std::max(max.y, other.max.y)));
+    }
+
+    AABB expanded(float margin) const {
+        return AABB(Point(min.x - margin, min.y - margin), Point(max.x + margin, max.y + margin));
+    }
+
+    // Périmètre : coût de la boîte pour l'heuristique d'insertion de l'arbre
+    float perimeter() const {
+        return 2.0f * ((max.x - min.x) + (max.y - min.y));
+    }
+
+    Point center() const {
+        return Point((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+    }
+
+    // Méthode des dalles : rayon origin + t * direction, t dans [0, maxT]
+    bool intersectsRay(const Point& origin, const Point& direction, float maxT, float& tEntry) const {
+        float tMin = 0.0f, tMax = maxT;
+        const float o[2] = {origin.x, origin.y};
+        const float d[2] = {direction.x, direction.y};
+        const float lo[2] = {min.x, min.y};
+        const float hi[2] = {max.x, max.y};
+        for (int axis = 0; axis < 2; axis++) {
+            if (d[axis] == 0.0f) {
+                if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+                    return false;
+                }
+                continue;
+            }
+            float inv = 1.0f / d[axis];
+            float t1 = (lo[axis] - o[axis]) * inv;
+            float t2 = (hi[axis] - o[axis]) * inv;
+            if (t1 > t2) {
+                std::swap(t1, t2);
+            }
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax) {
+                return false;
+            }
+        }
+        tEntry = tMin;
+        return true;
+    }
+};
+
+#endif // AABB_H
@@ -0,0 +1,38 @@
+﻿#ifndef AFFINE2D_H
+#define AFFINE2D_H
+
+#include "Point.h"
+
+// Transformation affine 2D (matrice 3x3 homogène)
+// | a  c  tx |
+// | b  d  ty |
+// | 0  0  1  |
+class Affine2D {
+public:
+    float a, b, c, d, tx, ty;
+
+    Affine2D(); // Identité
+    Affine2D(float a, float b, float c, float d, float tx, float ty);
+
+    // Transformations élémentaires
+    static Affine2D translation(float dx, float dy);
+    static Affine2D scaling(float sx, float sy);
+    static Affine2D rotation(float radians);
+    static Affine2D shearing(float shx, float shy);
+
+    // Applique une transformation autour d'un point pivot
+    static Affine2D about(const Affine2D& transform, const Point& pivot);
+
+    // Composition : (A * B)(p) = A(B(p))
+    Affine2D operator*(const Affine2D& other) const;
+
+    Point apply(const Point& p) const;
+    Affine2D inverse() const;
+    float determinant() const;
+    bool isIdentity() const;
+
+    // Matrice 3x3 en colonnes, prête pour glUniformMatrix3fv
+    void toColumnMajor(float out[9]) const;
+};
+
+#endif // AFFINE2D_H
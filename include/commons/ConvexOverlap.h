@@ -0,0 +1,42 @@
+﻿#ifndef CONVEX_OVERLAP_H
+#define CONVEX_OVERLAP_H
+
+#include <vector>
+#include "Point.h"
+
+// Résultat d'un test de chevauchement entre deux polygones convexes A et B
+struct OverlapResult {
+    bool overlap = false;
+    bool aContainsB = false;
+    bool bContainsA = false;
+    // Sans chevauchement : axe séparateur (unitaire, orienté de A vers B) et distance entre A et B.
+    // Avec chevauchement : direction de pénétration minimale (déplacer B de axis * depth les sépare).
+    Point axis;
+    float distance = 0.0f;
+    float depth = 0.0f;
+};
+
+// Test de chevauchement de polygones convexes par axes séparateurs en O(n + m) :
+// les normales des arêtes des deux polygones sont exactement les normales des arêtes de la
+// différence de Minkowski A - B, construite par fusion des arêtes triées par angle.
+// Les polygones se chevauchent si et seulement si l'origine est dans A - B.
+class ConvexOverlap {
+public:
+    // Polygones convexes dans le sens trigonométrique (voir BezierCurve::computeConvexHull).
+    // cachedAxis : axe séparateur de l'image précédente, testé en premier (cohérence temporelle)
+    static OverlapResult test(const std::vector<Point>& a, const std::vector<Point>& b,
+                              const Point* cachedAxis = nullptr);
+
+    // Point dans un polygone convexe (bord inclus), en O(log n)
+    static bool containsPoint(const std::vector<Point>& polygon, const Point& p);
+
+    // Différence de Minkowski A - B (sens trigonométrique)
+    static std::vector<Point> minkowskiDifference(const std::vector<Point>& a, const std::vector<Point>& b);
+
+private:
+    static bool separatedAlong(const std::vector<Point>& a, const std::vector<Point>& b,
+                               const Point& axis, OverlapResult& result);
+    static bool containsAll(const std::vector<Point>& polygon, const std::vector<Point>& points);
+};
+
+#endif // CONVEX_OVERLAP_H
@@ -0,0 +1,113 @@
+﻿#ifndef DYNAMIC_AABB_TREE_H
+#define DYNAMIC_AABB_TREE_H
+
+#include <vector>
+#include "AABB.h"
+
+// Hiérarchie de boîtes englobantes dynamique (arbre binaire équilibré par rotations).
+// Chaque feuille stocke une boîte élargie d'une marge : tant que la boîte réelle reste
+// à l'intérieur, un déplacement ne modifie pas l'arbre (voir moveProxy).
+// Les requêtes appellent un callback par feuille touchée ; il retourne false pour arrêter.
+// Chaque requête a sa propre pile de parcours : un callback peut lancer une autre requête.
+class DynamicAABBTree {
+public:
+    static constexpr int NULL_NODE = -1;
+
+    explicit DynamicAABBTree(float margin = 0.02f);
+
+    // Ajoute une feuille et retourne son identifiant (stable jusqu'à destroyProxy)
+    int createProxy(const AABB& box, int userData);
+    void destroyProxy(int proxyId);
+    // Retourne true si la feuille a été réinsérée (la boîte est sortie de sa marge)
+    bool moveProxy(int proxyId, const AABB& box);
+    void clear();
+
+    int getUserData(int proxyId) const;
+    const AABB& getFatAABB(int proxyId) const;
+    int getProxyCount() const;
+    int getHeight() const;
+
+    template <typename Callback>
+    void queryPoint(const Point& point, Callback callback) const {
+        traverse([&](const AABB& box) { return box.contains(point); }, callback);
+    }
+
+    template <typename Callback>
+    void queryBox(const AABB& area, Callback callback) const {
+        traverse([&](const AABB& box) { return box.overlaps(area); }, callback);
+    }
+
+    // Feuilles traversées par le rayon origin + t * direction, t dans [0, maxT]
+    template <typename Callback>
+    void queryRay(const Point& origin, const Point& direction, float maxT, Callback callback) const {
+        float tEntry;
+        traverse([&](const AABB& box) { return box.intersectsRay(origin, direction, maxT, tEntry); },
+                 callback);
+    }
+
+private:
+    struct Node {
+        AABB box;
+        int parent = NULL_NODE; // ou suivant dans la liste libre
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+        int height = -1;        // 0 pour une feuille, -1 pour un nœud libre
+        int userData = -1;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::vector<Node> nodes;
+    int root;
+    int freeList;
+    int proxyCount;
+    float margin;
+
+    // Profondeur de parcours tenue sur la pile d'appel ; au-delà, la pile passe sur le tas
+    static constexpr int INLINE_STACK_SIZE = 64;
+
+    int allocateNode();
+    void freeNode(int nodeId);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int nodeId);
+    void refit(int nodeId);
+
+    template <typename Test, typename Callback>
+    void traverse(Test test, Callback callback) const {
+        if (root == NULL_NODE) {
+            return;
+        }
+        int inlineStack[INLINE_STACK_SIZE];
+        std::vector<int> heapStack;
+        int* stack = inlineStack;
+        int capacity = INLINE_STACK_SIZE;
+        int size = 0;
+        stack[size++] = root;
+        while (size > 0) {
+            int nodeId = stack[--size];
+            const Node& node = nodes[nodeId];
+            if (!test(node.box)) {
+                continue;
+            }
+            if (node.isLeaf()) {
+                if (!callback(nodeId)) {
+                    return;
+                }
+            } else {
+                if (size + 2 > capacity) {
+                    if (stack == inlineStack) {
+                        heapStack.assign(inlineStack, inlineStack + size);
+                    }
+                    capacity *= 2;
+                    heapStack.resize(capacity);
+                    stack = heapStack.data();
+                }
+                stack[size++] = node.child1;
+                stack[size++] = node.child2;
+            }
+        }
+    }
+};
+
+#endif // DYNAMIC_AABB_TREE_H
@@ -42,6 +42,13 @@ public:
 		}
 	}
 
+	void SetUniformMatrix3(const char* name, const float* values) {
+		GLint location = glGetUniformLocation(m_Program, name);
+		if (location != -1) {
+			glUniformMatrix3fv(location, 1, GL_FALSE, values);
+		}
+	}
+
 private:
 	GLuint m_Program;
 	GLuint m_VertexShader;
@@ -0,0 +1,39 @@
+﻿#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+// Nombre de threads à utiliser pour workItems éléments : requested (0 : nombre de cœurs), sans
+// descendre sous minItemsPerThread éléments par thread (en dessous, la création des threads domine)
+inline int parallelThreadCount(int requested, size_t workItems, size_t minItemsPerThread) {
+    int available = requested > 0 ? requested : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    size_t useful = std::max<size_t>(1, workItems / minItemsPerThread);
+    return static_cast<int>(std::min<size_t>(available, useful));
+}
+
+// Découpe [0, count) en tranches contiguës, une par thread : function(begin, end, worker), avec
+// worker dans [0, threads) pour que chaque thread puisse utiliser ses propres tampons
+template <typename Function>
+void parallelFor(size_t count, int threads, Function function) {
+    if (threads <= 1) {
+        function(size_t(0), count, 0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    size_t chunk = (count + threads - 1) / threads;
+    for (int t = 1; t < threads; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(function, begin, end, t);
+    }
+    function(size_t(0), std::min(count, chunk), 0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // PARALLEL_FOR_H
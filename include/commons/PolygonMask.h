@@ -0,0 +1,43 @@
+﻿#ifndef POLYGON_MASK_H
+#define POLYGON_MASK_H
+
+#include <vector>
+#include <cstdint>
+#include "Point.h"
+#include "AABB.h"
+
+// Classification rapide de points par rapport à un polygone quelconque (lasso), règle pair-impair.
+// Le polygone est rastérisé sur une grille couvrant sa boîte englobante :
+// - une case qu'aucune arête ne traverse est entièrement dedans ou dehors (état de son centre,
+//   obtenu par un balayage horizontal par ligne de cases) : test en O(1) ;
+// - dans une case traversée, on part de l'état connu du centre et on compte les arêtes de la
+//   case coupées par le segment centre -> point.
+class PolygonMask {
+public:
+    PolygonMask();
+
+    // resolution : nombre de cases par côté (0 : choisi selon le nombre d'arêtes)
+    void build(const std::vector<Point>& polygon, int resolution = 0);
+    bool contains(const Point& p) const;
+
+    const AABB& getBounds() const { return bounds; }
+    bool empty() const { return polygon.size() < 3; }
+    // Case entièrement intérieure (aucune arête ne la traverse) : utile pour accepter des boîtes entières
+    bool containsBox(const AABB& box) const;
+
+private:
+    std::vector<Point> polygon;
+    AABB bounds;
+    int resolution;
+    float cellWidth, cellHeight;
+    std::vector<uint8_t> centerInside;   // état du centre de chaque case
+    std::vector<uint32_t> cellStart;     // arêtes de la case c : edges[cellStart[c] .. cellStart[c + 1][
+    std::vector<uint32_t> edges;
+
+    int cellIndex(int cx, int cy) const { return cy * resolution + cx; }
+    Point cellCenter(int cx, int cy) const;
+    bool segmentTouchesCell(const Point& a, const Point& b, int cx, int cy) const;
+    static bool segmentsCross(const Point& p1, const Point& p2, const Point& q1, const Point& q2);
+};
+
+#endif // POLYGON_MASK_H
@@ -0,0 +1,98 @@
+﻿#ifndef SPATIAL_HASH_GRID_H
+#define SPATIAL_HASH_GRID_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+#include "Point.h"
+
+// Grille uniforme hachée indexant des points identifiés par une clé 64 bits.
+// Ajout, déplacement et retrait sont en O(1) : chaque entrée connaît sa case et sa
+// position dans la liste de la case (retrait par échange avec le dernier élément).
+// Les requêtes ne visitent que les cases couvertes par le disque de recherche et
+// comparent des distances au carré.
+class SpatialHashGrid {
+public:
+    explicit SpatialHashGrid(float cellSize = 0.05f);
+
+    void insert(uint64_t id, const Point& point);
+    // Insère le point s'il n'est pas encore indexé
+    void move(uint64_t id, const Point& point);
+    void remove(uint64_t id);
+    bool contains(uint64_t id) const;
+    const Point& position(uint64_t id) const;
+    void clear();
+    size_t size() const { return entries.size(); }
+
+    // Change la taille des cases et réindexe tous les points
+    void setCellSize(float size);
+    float getCellSize() const { return cellSize; }
+
+    // Point le plus proche à une distance strictement inférieure à radius parmi ceux
+    // acceptés par filter(id) ; retourne false si aucun
+    template <typename Filter>
+    bool findNearest(const Point& center, float radius, uint64_t& nearestId, Filter filter) const {
+        float bestSquared = radius * radius;
+        bool found = false;
+        queryRadius(center, radius, [&](uint64_t id, const Point& p) {
+            float dx = p.x - center.x;
+            float dy = p.y - center.y;
+            float squared = dx * dx + dy * dy;
+            if (squared < bestSquared && filter(id)) {
+                bestSquared = squared;
+                nearestId = id;
+                found = true;
+            }
+        });
+        return found;
+    }
+
+    bool findNearest(const Point& center, float radius, uint64_t& nearestId) const {
+        return findNearest(center, radius, nearestId, [](uint64_t) { return true; });
+    }
+
+    // Appelle callback(id, point) pour chaque point des cases touchées par le disque
+    // (le filtrage exact par la distance est laissé à l'appelant)
+    template <typename Callback>
+    void queryRadius(const Point& center, float radius, Callback callback) const {
+        int minX = cellCoord(center.x - radius), maxX = cellCoord(center.x + radius);
+        int minY = cellCoord(center.y - radius), maxY = cellCoord(center.y + radius);
+        for (int cy = minY; cy <= maxY; cy++) {
+            for (int cx = minX; cx <= maxX; cx++) {
+                auto it = cells.find(cellKey(cx, cy));
+                if (it == cells.end()) {
+                    continue;
+                }
+                for (uint32_t e : it->second) {
+                    callback(entries[e].id, entries[e].point);
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        uint64_t id;
+        Point point;
+        uint64_t cell;
+        uint32_t slotInCell; // position dans cells[cell]
+    };
+
+    float cellSize;
+    float inverseCellSize;
+    std::vector<Entry> entries;                               // dense
+    std::unordered_map<uint64_t, uint32_t> entryOf;           // id -> indice dans entries
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells; // case -> indices dans entries
+
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v * inverseCellSize)); }
+    static uint64_t cellKey(int cx, int cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+    uint64_t cellOf(const Point& p) const { return cellKey(cellCoord(p.x), cellCoord(p.y)); }
+
+    void link(uint32_t entry);
+    void unlink(uint32_t entry);
+};
+
+#endif // SPATIAL_HASH_GRID_H
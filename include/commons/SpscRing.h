@@ -0,0 +1,52 @@
+﻿#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+
+// File circulaire sans verrou à un producteur et un consommateur.
+// Les indices croissent sans fin et sont réduits par masque (capacité puissance de deux) ;
+// chaque côté n'écrit que son propre indice, publié avec une sémantique release.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "La capacité doit être une puissance de deux");
+
+public:
+    // Producteur : false si la file est pleine (l'élément n'est pas ajouté)
+    bool push(const T& value) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        buffer[tail & MASK] = value;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consommateur : false si la file est vide
+    bool pop(T& value) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = buffer[head & MASK];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return headIndex.load(std::memory_order_acquire) == tailIndex.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    std::array<T, Capacity> buffer{};
+    // Indices sur des lignes de cache distinctes : producteur et consommateur ne se gênent pas
+    alignas(64) std::atomic<size_t> headIndex{0};
+    alignas(64) std::atomic<size_t> tailIndex{0};
+};
+
+#endif // SPSC_RING_H
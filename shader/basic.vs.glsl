@@ -2,8 +2,10 @@
 layout (location = 0) in vec2 aPosition;
 
 uniform mat4 projection;  // Add this line
+uniform mat3 model;       // Transformation affine de la courbe
 
 void main() {
-    gl_Position = projection * vec4(aPosition, 0.0, 1.0);  // Use projection
+    vec3 position = model * vec3(aPosition, 1.0);
+    gl_Position = projection * vec4(position.xy, 0.0, 1.0);  // Use projection
     gl_PointSize = 30.0;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <filesystem>
 #include <sstream>
+#include <limits>
 
 #include "imgui.h"
 #include "libs/imfilebrowser.h"
@@ -22,7 +23,8 @@
 
 void BezierApp::render() {
     glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    // Stencil : remplissage pair-impair des régions découpées (voir BezierCurve::drawClippedContours)
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
     // Disable depth testing for 2D
     glDisable(GL_DEPTH_TEST);
@@ -35,16 +37,16 @@ void BezierApp::render() {
     if (projLoc != -1) {
         glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
     }
+    // Matrice de modèle identité : chaque courbe applique sa propre transformation au dessin
+    float model[9];
+    Affine2D().toColumnMajor(model);
+    shader->SetUniformMatrix3("model", model);
     shader->End();
 
     // Draw all curves
-    for (auto& curve : curves) {
-        if (enableClipping && clipWindow.size() >= 3) {
-            curve.draw(*shader, &clipWindow);
-        } else {
-            curve.draw(*shader);
-        }
-    }
+    drawCurves();
+    renderSelection();
+    renderPointSelection();
 
     // Create buffers for points
     static GLuint pointVAO = 0, pointVBO = 0;
@@ -63,12 +65,12 @@ void BezierApp::render() {
     glBindVertexArray(pointVAO);
 
     // === DRAW CONTROL POINTS AS SMALL TRIANGLES (more visible than points) ===
-    if (selectedCurveIterator != curves.end()) {
-        for (int i = 0; i < selectedCurveIterator->getControlPointCount(); i++) {
-            Point p = selectedCurveIterator->getControlPoint(i);
+    if (curves.isValid(selectedCurve)) {
+        for (int i = 0; i < curves.get(selectedCurve)->getControlPointCount(); i++) {
+            Point p = curves.get(selectedCurve)->getControlPoint(i);
 
             // Set color
-            if (i == hoveredPointIndex) {
+            if (hoveredCurve == selectedCurve && i == hoveredPointIndex) {
                 shader->SetUniform("color", 1.0f, 0.6f, 0.0f); // Orange
             } else if (i == selectedPointIndex) {
                 shader->SetUniform("color", 0.0f, 1.0f, 0.0f); // Green
@@ -116,6 +118,7 @@ void BezierApp::render() {
         // Draw clipping window lines
         if (clipWindow.size() >= 2) {
             static GLuint lineVAO = 0, lineVBO = 0;
+            static uint64_t uploadedVersion = 0;
             if (lineVAO == 0) {
                 glGenVertexArrays(1, &lineVAO);
                 glGenBuffers(1, &lineVBO);
@@ -126,16 +129,20 @@ void BezierApp::render() {
                 glEnableVertexAttribArray(0);
             }
 
-            if (CyrusBeck::isPolygonConvex(clipWindow)) {
+            if (clipWindow.isConvex()) {
                 shader->SetUniform("color", 0.7f, 0.7f, 0.0f);
             } else {
                 shader->SetUniform("color", 1.0f, 0.0f, 0.0f);
             }
 
             glBindVertexArray(lineVAO);
-            glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-            glBufferData(GL_ARRAY_BUFFER, clipWindow.size() * sizeof(Point),
-                         clipWindow.data(), GL_STREAM_DRAW);
+            // Contour transféré seulement quand la fenêtre a changé
+            if (uploadedVersion != clipWindow.getVersion()) {
+                glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
+                glBufferData(GL_ARRAY_BUFFER, clipWindow.size() * sizeof(Point),
+                             clipWindow.getVertices().data(), GL_DYNAMIC_DRAW);
+                uploadedVersion = clipWindow.getVersion();
+            }
             glDrawArrays(GL_LINE_LOOP, 0, clipWindow.size());
         }
     }
@@ -145,15 +152,17 @@ void BezierApp::render() {
 }
 
 BezierApp::BezierApp(const char* title, int width, int height)
-        : width(width), height(height), currentMode(Mode::ADD_CONTROL_POINTS),
-          selectedCurveIterator(curves.end()), selectedPointIndex(-1),
-          selectedClipPointIndex(-1), enableClipping(false),
+        : width(width), height(height),
+          currentViewMode(ViewMode::VIEW_2D),
+          deltaTime(0.0f),
+          lastFrame(0.0f),
           mouseX(0.0f), mouseY(0.0f), screenMouseX(0), screenMouseY(0),
-          isPointHovered(false), hoveredPointIndex(-1),
-          hoveredClipPointIndex(-1), cursorMode(CursorMode::HIDDEN),
-          usesSutherlandHodgman(false),
+          isPointHovered(false), hoveredPointIndex(-1), cursorMode(CursorMode::HIDDEN),
+          currentMode(Mode::ADD_CONTROL_POINTS),
+          selectedPointIndex(-1),
+          selectedClipPointIndex(-1), enableClipping(false), hoveredClipPointIndex(-1),
+          clippingAlgorithm(BezierCurve::ClippingAlgorithm::CYRUS_BECK),
         // === NOUVELLES INITIALISATIONS 3D ===
-          currentViewMode(ViewMode::VIEW_2D),
           renderMode3D(RenderMode3D::SOLID_WITH_LIGHTING),
           currentExtrusionType(ExtrusionType::LINEAR),
           camera3D(glm::vec3(0.0f, 0.0f, 3.0f)),
@@ -167,8 +176,6 @@ BezierApp::BezierApp(const char* title, int width, int height)
           lightColor(1.0f, 1.0f, 1.0f),
           // objectColor(0.8f, 0.6f, 0.4f),
           objectColor(1.f,1.f,1.f), // White for better visibility
-          deltaTime(0.0f),
-          lastFrame(0.0f),
           cameraControlEnabled(false),
           firstMouse(true),
           lastMouseX(width / 2.0f),
@@ -240,14 +247,16 @@ BezierApp::BezierApp(const char* title, int width, int height)
     // Configuration des callbacks
     glfwSetWindowUserPointer(window, this);
 
+    // Les événements d'entrée sont seulement mis en file ; ils sont traités une fois par image
+    // dans drainInputEvents()
     glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods) {
         BezierApp* app = static_cast<BezierApp*>(glfwGetWindowUserPointer(window));
-        app->mouseButtonCallback(button, action, mods);
+        app->pushInputEvent({InputEvent::Type::MOUSE_BUTTON, button, action, mods, 0, 0.0, 0.0});
     });
 
     glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
         BezierApp* app = static_cast<BezierApp*>(glfwGetWindowUserPointer(window));
-        app->keyCallback(key, scancode, action, mods);
+        app->pushInputEvent({InputEvent::Type::KEY, key, action, mods, scancode, 0.0, 0.0});
     });
 
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
@@ -257,7 +266,12 @@ BezierApp::BezierApp(const char* title, int width, int height)
 
     glfwSetCursorPosCallback(window, [](GLFWwindow* window, double xpos, double ypos) {
         BezierApp* app = static_cast<BezierApp*>(glfwGetWindowUserPointer(window));
-        app->cursorPositionCallback(xpos, ypos);
+        app->pushInputEvent({InputEvent::Type::CURSOR_MOVE, 0, 0, 0, 0, xpos, ypos});
+    });
+
+    glfwSetScrollCallback(window, [](GLFWwindow* window, double xoffset, double yoffset) {
+        BezierApp* app = static_cast<BezierApp*>(glfwGetWindowUserPointer(window));
+        app->pushInputEvent({InputEvent::Type::SCROLL, 0, 0, 0, 0, xoffset, yoffset});
     });
 
     // Création du VAO/VBO pour le curseur
@@ -265,6 +279,7 @@ BezierApp::BezierApp(const char* title, int width, int height)
 
     // Création de la première courbe vide
     createNewCurve();
+    history.clear();
 
     // Initialiser ImGui
     imguiManager.init(window);
@@ -272,6 +287,9 @@ BezierApp::BezierApp(const char* title, int width, int height)
     // Initialiser les descriptions des commandes
     initCommandDescriptions();
 
+    // Cibles d'aimantation branchées sur les index spatiaux
+    setupSnapProviders();
+
     // === CONFIGURATION 3D ===
     glEnable(GL_DEPTH_TEST);
     setupShaders3D();
@@ -333,34 +351,30 @@ BezierApp::~BezierApp() {
         }
     }
 
-    glfwSetScrollCallback(window, [](GLFWwindow* window, double xoffset, double yoffset) {
-        BezierApp* app = static_cast<BezierApp*>(glfwGetWindowUserPointer(window));
-
-        // Vérifier si ImGui veut capturer la molette
-        ImGuiIO& io = ImGui::GetIO();
-        if (io.WantCaptureMouse) return;
-
-        if (app->currentViewMode != ViewMode::VIEW_2D) {
-            app->camera3D.processMouseScroll(static_cast<float>(yoffset));
-        }
-    });
-
     glfwTerminate();
 }
 
 // Implémentez la méthode pour basculer entre les algorithmes
 void BezierApp::toggleClippingAlgorithm() {
-    usesSutherlandHodgman = !usesSutherlandHodgman;
+    // Cyrus-Beck -> Sutherland-Hodgman -> Greiner-Hormann -> Cyrus-Beck
+    switch (clippingAlgorithm) {
+        case BezierCurve::ClippingAlgorithm::CYRUS_BECK:
+            clippingAlgorithm = BezierCurve::ClippingAlgorithm::SUTHERLAND_HODGMAN;
+            break;
+        case BezierCurve::ClippingAlgorithm::SUTHERLAND_HODGMAN:
+            clippingAlgorithm = BezierCurve::ClippingAlgorithm::GREINER_HORMANN;
+            break;
+        case BezierCurve::ClippingAlgorithm::GREINER_HORMANN:
+            clippingAlgorithm = BezierCurve::ClippingAlgorithm::CYRUS_BECK;
+            break;
+    }
 
     // Mettre à jour l'algorithme pour toutes les courbes
     for (auto& curve : curves) {
-        curve.setClippingAlgorithm(usesSutherlandHodgman ?
-                                   BezierCurve::ClippingAlgorithm::SUTHERLAND_HODGMAN :
-                                   BezierCurve::ClippingAlgorithm::CYRUS_BECK);
+        curve.setClippingAlgorithm(clippingAlgorithm);
     }
 
-    std::cout << "Algorithme de découpage changé pour: " <<
-              (usesSutherlandHodgman ? "Sutherland-Hodgman" : "Cyrus-Beck") << std::endl;
+    std::cout << "Algorithme de découpage changé pour: " << getClippingAlgorithmString() << std::endl;
 }
 
 void BezierApp::setupShaders3D() {
@@ -437,6 +451,87 @@ void BezierApp::mouseToOpenGL(double mouseX, double mouseY, float& oglX, float&
     }
 }
 
+void BezierApp::pushInputEvent(const InputEvent& event) {
+    // Une fois la file pleine, les événements suivants attendent dans la réserve, dans leur ordre
+    // d'arrivée, pour ne jamais passer devant ceux de la file
+    if (inputOverflow.empty() && inputEvents.push(event)) {
+        return;
+    }
+    // Seuls les déplacements du curseur peuvent être perdus : un déplacement remplace celui qui
+    // termine la réserve. Clics, touches et molette sont tous gardés (un relâchement perdu
+    // laisserait un glissement ou une touche bloqués).
+    if (event.type == InputEvent::Type::CURSOR_MOVE && !inputOverflow.empty() &&
+        inputOverflow.back().type == InputEvent::Type::CURSOR_MOVE) {
+        inputOverflow.back() = event;
+        droppedInputEvents++;
+        return;
+    }
+    inputOverflow.push_back(event);
+}
+
+void BezierApp::drainInputEvents() {
+    // Les déplacements consécutifs sont fusionnés : seul le dernier est traité (survol, édition),
+    // et il l'est avant tout clic ou touche qui le suit pour garder la position de l'événement
+    InputEvent queued;
+    InputEvent pendingMove;
+    bool hasPendingMove = false;
+    inputStats = InputStats();
+
+    auto handleEvent = [&](const InputEvent& event) {
+        inputStats.received++;
+        if (event.type == InputEvent::Type::CURSOR_MOVE) {
+            pendingMove = event;
+            hasPendingMove = true;
+            return;
+        }
+        if (hasPendingMove) {
+            cursorPositionCallback(pendingMove.x, pendingMove.y);
+            inputStats.processed++;
+            hasPendingMove = false;
+        }
+
+        switch (event.type) {
+            case InputEvent::Type::MOUSE_BUTTON:
+                mouseButtonCallback(event.code, event.action, event.mods);
+                break;
+            case InputEvent::Type::KEY:
+                keyCallback(event.code, event.scancode, event.action, event.mods);
+                break;
+            case InputEvent::Type::SCROLL:
+                scrollCallback(event.x, event.y);
+                break;
+            case InputEvent::Type::CURSOR_MOVE:
+                break;
+        }
+        inputStats.processed++;
+    };
+
+    while (inputEvents.pop(queued)) {
+        handleEvent(queued);
+    }
+    // Événements arrivés file pleine, à la suite de ceux de la file. GLFW appelle les callbacks
+    // depuis glfwPollEvents, sur ce même thread : la réserve est lue ici sans synchronisation.
+    for (const InputEvent& overflowEvent : inputOverflow) {
+        handleEvent(overflowEvent);
+    }
+    inputOverflow.clear();
+
+    if (hasPendingMove) {
+        cursorPositionCallback(pendingMove.x, pendingMove.y);
+        inputStats.processed++;
+    }
+}
+
+void BezierApp::scrollCallback(double xoffset, double yoffset) {
+    // Vérifier si ImGui veut capturer la molette
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.WantCaptureMouse) return;
+
+    if (currentViewMode != ViewMode::VIEW_2D) {
+        camera3D.processMouseScroll(static_cast<float>(yoffset));
+    }
+}
+
 void BezierApp::cursorPositionCallback(double xpos, double ypos) {
     if (cameraControlEnabled && currentViewMode != ViewMode::VIEW_2D) {
         if (firstMouse) {
@@ -477,46 +572,267 @@ void BezierApp::cursorPositionCallback(double xpos, double ypos) {
     if (!isPointHovered) {
         checkClipPointHover(mouseX, mouseY);
     }
+
+    // Le lasso suit la position réelle ; un sommet par déplacement significatif suffit
+    if (isLassoSelecting && lassoPoints.back().distanceTo(Point(mouseX, mouseY)) > selectionPadding / 4) {
+        lassoPoints.emplace_back(mouseX, mouseY);
+    }
+
+    // Aimantation de la position utilisée par les éditions (le survol garde la position réelle)
+    rawMouseX = mouseX;
+    rawMouseY = mouseY;
+    updateSnap();
 }
 
 bool BezierApp::checkPointHover(float x, float y) {
-    // Vérifie si un point de contrôle est survolé
+    // Vérifie si un point de contrôle est survolé : en édition, les points de toutes les
+    // courbes comptent (un clic passe sur la courbe survolée), en ajout seulement la courbe courante
     hoveredPointIndex = -1;
+    hoveredCurve = CurveHandle();
+
+    syncPointGrid();
+    bool anyCurve = currentMode == Mode::EDIT_CONTROL_POINTS || currentMode == Mode::SELECT_POINTS;
+    uint32_t selectedSlot = selectedCurve.index;
+    uint64_t id;
+    if (!pointGrid.findNearest(Point(x, y), selectionPadding, id, [&](uint64_t candidate) {
+            return !(candidate & CLIP_POINT_TAG) && (anyCurve || (candidate >> 32) == selectedSlot);
+        })) {
+        return false;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(id >> 32);
+    hoveredCurve = CurveHandle{slot, pointGridCurves[slot].generation};
+    hoveredPointIndex = static_cast<int>(id & 0xFFFFFFFFu);
+    return true;
+}
 
-    if (selectedCurveIterator == curves.end()) return false;
+bool BezierApp::checkClipPointHover(float x, float y) {
+    // Vérifie si un point de découpage est survolé
+    hoveredClipPointIndex = -1;
+
+    if (clipWindow.empty()) return false;
 
-    // Vérifier chaque point de contrôle avec le padding de sélection
-    for (int i = 0; i < selectedCurveIterator->getControlPointCount(); i++) {
-        Point p = selectedCurveIterator->getControlPoint(i);
-        float distance = std::sqrt((p.x - x) * (p.x - x) + (p.y - y) * (p.y - y));
+    uint64_t id;
+    if (!pointGrid.findNearest(Point(x, y), selectionPadding, id,
+                               [](uint64_t candidate) { return (candidate & CLIP_POINT_TAG) != 0; })) {
+        return false;
+    }
+    hoveredClipPointIndex = static_cast<int>(id & ~CLIP_POINT_TAG);
+    return true;
+}
 
-        if (distance < selectionPadding) {
-            hoveredPointIndex = i;
-            return true;
+// === INDEX SPATIAL DES POINTS ===
+void BezierApp::syncPointGrid() {
+    // Cases de deux rayons de sélection : un survol visite au plus 3x3 cases
+    pointGrid.setCellSize(selectionPadding * 2.0f);
+    syncCurveIndexes();
+}
+
+void BezierApp::reindexCurvePoints(uint32_t slot, CurveHandle handle, const BezierCurve* curve) {
+    if (slot >= pointGridCurves.size()) {
+        pointGridCurves.resize(slot + 1);
+    }
+    PointGridCurve& state = pointGridCurves[slot];
+
+    // Courbe supprimée : retirer ses points
+    if (!curve) {
+        for (int i = 0; i < state.count; i++) {
+            pointGrid.remove(curvePointId(slot, i));
         }
+        state = PointGridCurve();
+        return;
+    }
+
+    // Déjà à jour par le chemin rapide (updatePointGrid)
+    if (state.generation == handle.generation && state.version == curve->getVersion()) {
+        return;
     }
+    state.generation = handle.generation;
 
-    return false;
+    // Modification hors des chemins incrémentaux (transformations, chargement, annulation...) :
+    // seuls les points déplacés changent de case
+    int count = curve->getControlPointCount();
+    for (int p = 0; p < count; p++) {
+        pointGrid.move(curvePointId(slot, p), curve->getControlPoint(p));
+    }
+    for (int p = count; p < state.count; p++) {
+        pointGrid.remove(curvePointId(slot, p));
+    }
+    state.count = count;
+    state.version = curve->getVersion();
 }
 
-bool BezierApp::checkClipPointHover(float x, float y) {
-    // Vérifie si un point de découpage est survolé
-    hoveredClipPointIndex = -1;
+void BezierApp::updatePointGrid(CurveHandle handle, int index, uint64_t previousVersion) {
+    // Chemin rapide d'un point déplacé ou ajouté en fin de courbe ; sinon syncCurveIndexes()
+    // réindexera la courbe (journal du CurveStore) au prochain survol ou à la prochaine image
+    const BezierCurve* curve = curves.get(handle);
+    if (!curve || handle.index >= pointGridCurves.size()) {
+        return;
+    }
+    PointGridCurve& state = pointGridCurves[handle.index];
+    if (state.generation != handle.generation || state.version != previousVersion) {
+        return;
+    }
 
-    if (clipWindow.empty()) return false;
+    int count = curve->getControlPointCount();
+    if (index < state.count && count == state.count) {
+        pointGrid.move(curvePointId(handle.index, index), curve->getControlPoint(index));
+    } else if (index == state.count && count == state.count + 1) {
+        pointGrid.insert(curvePointId(handle.index, index), curve->getControlPoint(index));
+        state.count = count;
+    } else {
+        return;
+    }
+    state.version = curve->getVersion();
+}
 
-    // Vérifier chaque point de découpage avec le padding de sélection
-    for (int i = 0; i < clipWindow.size(); i++) {
-        Point p = clipWindow[i];
-        float distance = std::sqrt((p.x - x) * (p.x - x) + (p.y - y) * (p.y - y));
+void BezierApp::syncClipGrid(int first) {
+    // Les sommets à partir de first ont changé (ajout, déplacement ou décalage après un retrait)
+    for (int i = first; i < static_cast<int>(clipWindow.size()); i++) {
+        pointGrid.move(clipPointId(i), clipWindow[i]);
+    }
+    for (int i = static_cast<int>(clipWindow.size()); i < clipGridCount; i++) {
+        pointGrid.remove(clipPointId(i));
+    }
+    clipGridCount = static_cast<int>(clipWindow.size());
+
+    // Arêtes touchant un sommet modifié, plus l'arête de fermeture
+    int count = static_cast<int>(clipWindow.size());
+    int edgeCount = count >= 2 ? count : 0;
+    while (static_cast<int>(clipEdgeProxies.size()) > edgeCount) {
+        clipEdgeTree.destroyProxy(clipEdgeProxies.back());
+        clipEdgeProxies.pop_back();
+    }
+    for (int i = std::max(0, first - 1); i < edgeCount; i++) {
+        updateClipEdge(i);
+    }
+    if (edgeCount > 0) {
+        updateClipEdge(edgeCount - 1);
+    }
+}
+
+void BezierApp::moveClipVertex(int index) {
+    // Déplacement d'un sommet : son point et ses deux arêtes seulement
+    pointGrid.move(clipPointId(index), clipWindow[index]);
+    int count = static_cast<int>(clipWindow.size());
+    if (count >= 2) {
+        updateClipEdge(index);
+        updateClipEdge((index + count - 1) % count);
+    }
+}
+
+void BezierApp::updateClipEdge(int edge) {
+    const Point& a = clipWindow[edge];
+    const Point& b = clipWindow[(edge + 1) % clipWindow.size()];
+    AABB box = AABB::fromPoints({a, b});
+    if (edge < static_cast<int>(clipEdgeProxies.size())) {
+        clipEdgeTree.moveProxy(clipEdgeProxies[edge], box);
+    } else {
+        clipEdgeProxies.push_back(clipEdgeTree.createProxy(box, edge));
+    }
+}
+
+// === AIMANTATION ===
+void BezierApp::setupSnapProviders() {
+    using Target = SnapEngine::Target;
+
+    snapEngine.setProvider(Target::CONTROL_POINT, [this](const Point& p, float radius, SnapEngine::Snap& snap) {
+        // Le point glissé ne s'aimante pas sur lui-même
+        bool dragging = currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1;
+        uint64_t dragged = dragging ? curvePointId(selectedCurve.index, selectedPointIndex) : CLIP_POINT_TAG;
+        uint64_t id;
+        if (!pointGrid.findNearest(p, radius, id, [dragged](uint64_t candidate) {
+                return !(candidate & CLIP_POINT_TAG) && candidate != dragged;
+            })) {
+            return false;
+        }
+        uint32_t slot = static_cast<uint32_t>(id >> 32);
+        snap.point = pointGrid.position(id);
+        snap.curve = CurveHandle{slot, pointGridCurves[slot].generation};
+        snap.index = static_cast<int>(id & 0xFFFFFFFFu);
+        return true;
+    });
 
-        if (distance < selectionPadding) {
-            hoveredClipPointIndex = i;
+    snapEngine.setProvider(Target::CLIP_VERTEX, [this](const Point& p, float radius, SnapEngine::Snap& snap) {
+        bool dragging = currentMode == Mode::EDIT_CLIP_WINDOW && selectedClipPointIndex != -1;
+        uint64_t dragged = dragging ? clipPointId(selectedClipPointIndex) : 0;
+        uint64_t id;
+        if (!pointGrid.findNearest(p, radius, id, [dragged](uint64_t candidate) {
+                return (candidate & CLIP_POINT_TAG) && candidate != dragged;
+            })) {
+            return false;
+        }
+        snap.point = pointGrid.position(id);
+        snap.index = static_cast<int>(id & ~CLIP_POINT_TAG);
+        return true;
+    });
+
+    snapEngine.setProvider(Target::CURVE, [this](const Point& p, float radius, SnapEngine::Snap& snap) {
+        // La courbe dont un point est glissé suit le curseur : elle est ignorée. Coût : courbes
+        // changées depuis la dernière requête (une seule pendant un glissé) plus les candidates
+        // de l'arbre, indépendant du nombre de courbes de la scène
+        bool dragging = currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1;
+        CurveHit hit;
+        CurveHandle curve = pickCurveHit(p.x, p.y, hit, radius, dragging ? selectedCurve : CurveHandle());
+        if (!curves.isValid(curve)) {
+            return false;
+        }
+        snap.point = hit.point;
+        snap.curve = curve;
+        snap.t = hit.t;
+        return true;
+    });
+
+    snapEngine.setProvider(Target::CLIP_EDGE, [this](const Point& p, float radius, SnapEngine::Snap& snap) {
+        int count = static_cast<int>(clipWindow.size());
+        int dragged = currentMode == Mode::EDIT_CLIP_WINDOW ? selectedClipPointIndex : -1;
+        float bestSquared = radius * radius;
+        bool found = false;
+        clipEdgeTree.queryBox(AABB(Point(p.x - radius, p.y - radius), Point(p.x + radius, p.y + radius)),
+                              [&](int proxyId) {
+            int edge = clipEdgeTree.getUserData(proxyId);
+            if (dragged != -1 && (edge == dragged || (edge + 1) % count == dragged)) {
+                return true;
+            }
+            const Point& a = clipWindow[edge];
+            const Point& b = clipWindow[(edge + 1) % count];
+            float abx = b.x - a.x, aby = b.y - a.y;
+            float lengthSquared = abx * abx + aby * aby;
+            float u = lengthSquared > 0.0f ? ((p.x - a.x) * abx + (p.y - a.y) * aby) / lengthSquared : 0.0f;
+            u = std::clamp(u, 0.0f, 1.0f);
+            Point q(a.x + abx * u, a.y + aby * u);
+            float squared = (q.x - p.x) * (q.x - p.x) + (q.y - p.y) * (q.y - p.y);
+            if (squared < bestSquared) {
+                bestSquared = squared;
+                snap.point = q;
+                snap.index = edge;
+                snap.t = u;
+                found = true;
+            }
             return true;
-        }
+        });
+        return found;
+    });
+}
+
+void BezierApp::updateSnap() {
+    snapActive = false;
+    if (currentViewMode == ViewMode::VIEW_DUAL && mouseX > 900.0f) {
+        return;
+    }
+
+    // Seules les positions qui vont modifier la scène sont aimantées
+    bool editing = currentMode == Mode::ADD_CONTROL_POINTS ||
+                   currentMode == Mode::CREATE_CLIP_WINDOW ||
+                   (currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1) ||
+                   (currentMode == Mode::EDIT_CLIP_WINDOW && selectedClipPointIndex != -1);
+    if (!editing || !snapEngine.snap(Point(mouseX, mouseY), currentSnap)) {
+        return;
     }
 
-    return false;
+    snapActive = true;
+    mouseX = currentSnap.point.x;
+    mouseY = currentSnap.point.y;
 }
 
 void BezierApp::initCommandDescriptions() {
@@ -534,12 +850,21 @@ void BezierApp::initCommandDescriptions() {
     commandDescriptions["R"] = "Appliquer une rotation";
     commandDescriptions["C"] = "Appliquer un cisaillement";
     commandDescriptions["Tab"] = "Passer à la courbe suivante";
+    commandDescriptions["J"] = "Mode sélection de courbes (clic, rectangle, Maj: ajouter)";
+    commandDescriptions["Maj+J"] = "Mode sélection de points (rectangle, Alt: lasso, Maj: ajouter)";
+    commandDescriptions["Ctrl+A"] = "Sélectionner toutes les courbes (tous les points en sélection de points)";
+    commandDescriptions["Ctrl+clic"] = "Insérer un point de contrôle sur la courbe (mode édition)";
+    commandDescriptions["I / Maj+I"] = "Intersections de la courbe courante / de toute la scène";
+    commandDescriptions["K / Maj+K"] = "Grouper la sélection / Dissoudre le groupe courant";
     commandDescriptions["F"] = "Mode création de fenêtre de découpage";
     commandDescriptions["G"] = "Mode édition de fenêtre de découpage";
+    commandDescriptions["Maj+G"] = "Activer/désactiver l'aimantation";
     commandDescriptions["X"] = "Activer/désactiver le découpage";
-    commandDescriptions["Delete"] = "Supprimer le point sélectionné";
+    commandDescriptions["Delete"] = "Supprimer le ou les points sélectionnés";
     commandDescriptions["Backspace"] = "Effacer la fenêtre de découpage";
-    commandDescriptions["Z"] = "Basculer entre Cyrus-Beck et Sutherland-Hodgman";
+    commandDescriptions["Z"] = "Algorithme de découpage suivant (Cyrus-Beck, Sutherland-Hodgman, Greiner-Hormann)";
+    commandDescriptions["Ctrl+Z"] = "Annuler la dernière action";
+    commandDescriptions["Ctrl+Y / Ctrl+Maj+Z"] = "Rétablir l'action annulée";
     commandDescriptions["Clic droit"] = "Activer/désactiver contrôle caméra 3D";
     commandDescriptions["WASD"] = "Déplacer la caméra (quand activée)";
     commandDescriptions["Q/E"] = "Monter/Descendre la caméra";
@@ -556,6 +881,10 @@ std::string BezierApp::getModeString() const {
             return "Création de fenêtre de découpage";
         case Mode::EDIT_CLIP_WINDOW:
             return "Édition de fenêtre de découpage";
+        case Mode::SELECT_CURVES:
+            return "Sélection de courbes";
+        case Mode::SELECT_POINTS:
+            return "Sélection de points";
         default:
             return "Inconnu";
     }
@@ -588,6 +917,15 @@ std::string BezierApp::getExtrusionTypeString() const {
     }
 }
 
+std::string BezierApp::getClippingAlgorithmString() const {
+    switch (clippingAlgorithm) {
+        case BezierCurve::ClippingAlgorithm::CYRUS_BECK: return "Cyrus-Beck";
+        case BezierCurve::ClippingAlgorithm::SUTHERLAND_HODGMAN: return "Sutherland-Hodgman";
+        case BezierCurve::ClippingAlgorithm::GREINER_HORMANN: return "Greiner-Hormann";
+        default: return "Inconnu";
+    }
+}
+
 void BezierApp::run() {
     // Afficher la version d'OpenGL et les informations du renderer
     const GLubyte* renderer = glGetString(GL_RENDERER);
@@ -606,6 +944,7 @@ void BezierApp::run() {
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        drainInputEvents();
         processInput();
 
         if (needsExtrusionUpdate) {
@@ -623,6 +962,12 @@ void BezierApp::run() {
             needsExtrusionUpdate = false;
         }
 
+        // Matrices monde des groupes modifiés, puis mises à jour différées des courbes
+        // (une seule par courbe et par image)
+        sceneGraph.update(curves);
+        flushCurveUpdates();
+        syncCurveIndexes();
+
         // Commencer la frame ImGui
         imguiManager.beginFrame();
 
@@ -730,19 +1075,15 @@ void BezierApp::renderDual() {
     glViewport(0, 0, width / 2, height);
 
     glClearColor(0.15f, 0.15f, 0.15f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_CULL_FACE);
 
     // Draw curves
-    for (auto& curve : curves) {
-        if (enableClipping && clipWindow.size() >= 3) {
-            curve.draw(*shader, &clipWindow);
-        } else {
-            curve.draw(*shader);
-        }
-    }
+    drawCurves();
+    renderSelection();
+    renderPointSelection();
 
     // Draw control points
     static GLuint pointVAO = 0, pointVBO = 0;
@@ -759,11 +1100,11 @@ void BezierApp::renderDual() {
     shader->Begin();
     glBindVertexArray(pointVAO);
 
-    if (selectedCurveIterator != curves.end()) {
-        for (int i = 0; i < selectedCurveIterator->getControlPointCount(); i++) {
-            Point p = selectedCurveIterator->getControlPoint(i);
+    if (curves.isValid(selectedCurve)) {
+        for (int i = 0; i < curves.get(selectedCurve)->getControlPointCount(); i++) {
+            Point p = curves.get(selectedCurve)->getControlPoint(i);
 
-            if (i == hoveredPointIndex) {
+            if (hoveredCurve == selectedCurve && i == hoveredPointIndex) {
                 shader->SetUniform("color", 1.0f, 0.6f, 0.0f);
             } else if (i == selectedPointIndex) {
                 shader->SetUniform("color", 0.0f, 1.0f, 0.0f);
@@ -854,8 +1195,16 @@ void BezierApp::processInput() {
     }
 
     // Utiliser les coordonnées mouseX et mouseY pour l'édition
-    if (currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1 && selectedCurveIterator != curves.end()) {
-        selectedCurveIterator->updateControlPoint(selectedPointIndex, mouseX, mouseY);
+    if (currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1 && curves.isValid(selectedCurve)) {
+        BezierCurve* curve = curves.get(selectedCurve);
+        Point from = curve->getControlPoint(selectedPointIndex);
+        if (from.x != mouseX || from.y != mouseY) {
+            uint64_t previousVersion = curve->getVersion();
+            curve->updateControlPoint(selectedPointIndex, mouseX, mouseY);
+            updatePointGrid(selectedCurve, selectedPointIndex, previousVersion);
+            // Les déplacements d'un même glisser sont fusionnés en une seule entrée
+            history.recordPointMove(selectedCurve, selectedPointIndex, from, Point(mouseX, mouseY));
+        }
 
         // ADD THIS: Trigger real-time extrusion update
         if (realTimeExtrusion && surfaceGenerated && currentViewMode != ViewMode::VIEW_2D) {
@@ -863,12 +1212,15 @@ void BezierApp::processInput() {
         }
     }
     else if (currentMode == Mode::EDIT_CLIP_WINDOW && selectedClipPointIndex != -1) {
-        clipWindow[selectedClipPointIndex].x = mouseX;
-        clipWindow[selectedClipPointIndex].y = mouseY;
-
-        if (clipWindow.size() >= 3) {
-            if (!CyrusBeck::isPolygonConvex(clipWindow)) {
-                std::cout << "Attention: La fenetre n'est pas convexe!" << std::endl;
+        // Souris immobile : la fenêtre ne change pas et les découpages en cache restent valides
+        const Point& vertex = clipWindow[selectedClipPointIndex];
+        if (vertex.x != mouseX || vertex.y != mouseY) {
+            bool wasConvex = clipWindow.isConvex();
+            clipWindow.moveVertex(selectedClipPointIndex, Point(mouseX, mouseY));
+            moveClipVertex(selectedClipPointIndex);
+
+            if (clipWindow.size() >= 3 && wasConvex && !clipWindow.isConvex()) {
+                std::cout << "La fenêtre n'est plus convexe : découpage général (Greiner-Hormann)" << std::endl;
             }
         }
     }
@@ -935,12 +1287,15 @@ void BezierApp::renderCursor() {
         shader->SetUniform("color", 1.0f, 1.0f, 1.0f);
     }
 
+    // La croix suit la position réelle ; l'indicateur d'aimantation marque la position retenue
+    float cursorX = snapActive ? rawMouseX : mouseX;
+    float cursorY = snapActive ? rawMouseY : mouseY;
     float cursorSize = 0.02f;
     float crossLines[] = {
-            mouseX - cursorSize, mouseY,
-            mouseX + cursorSize, mouseY,
-            mouseX, mouseY - cursorSize,
-            mouseX, mouseY + cursorSize
+            cursorX - cursorSize, cursorY,
+            cursorX + cursorSize, cursorY,
+            cursorX, cursorY - cursorSize,
+            cursorX, cursorY + cursorSize
     };
 
     // Create/bind VAO and VBO for cursor
@@ -959,6 +1314,38 @@ void BezierApp::renderCursor() {
     glBindBuffer(GL_ARRAY_BUFFER, cursorVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(crossLines), crossLines, GL_STREAM_DRAW);
     glDrawArrays(GL_LINES, 0, 4);
+
+    if (snapActive) {
+        // Carré : point ou sommet ; losange : courbe ou arête ; petit carré : nœud de la grille
+        float s = 0.015f;
+        float indicator[8];
+        switch (currentSnap.target) {
+            case SnapEngine::Target::CONTROL_POINT:
+            case SnapEngine::Target::CLIP_VERTEX:
+                shader->SetUniform("color", 1.0f, 0.9f, 0.0f);
+                break;
+            case SnapEngine::Target::CURVE:
+            case SnapEngine::Target::CLIP_EDGE:
+                shader->SetUniform("color", 1.0f, 0.0f, 1.0f);
+                break;
+            default:
+                shader->SetUniform("color", 0.5f, 0.5f, 1.0f);
+                s = 0.01f;
+                break;
+        }
+        bool diamond = currentSnap.target == SnapEngine::Target::CURVE ||
+                       currentSnap.target == SnapEngine::Target::CLIP_EDGE;
+        float x = currentSnap.point.x, y = currentSnap.point.y;
+        if (diamond) {
+            float shape[] = {x - s, y, x, y - s, x + s, y, x, y + s};
+            std::copy(shape, shape + 8, indicator);
+        } else {
+            float shape[] = {x - s, y - s, x + s, y - s, x + s, y + s, x - s, y + s};
+            std::copy(shape, shape + 8, indicator);
+        }
+        glBufferData(GL_ARRAY_BUFFER, sizeof(indicator), indicator, GL_STREAM_DRAW);
+        glDrawArrays(GL_LINE_LOOP, 0, 4);
+    }
     glBindVertexArray(0);
 
     shader->End();
@@ -984,19 +1371,123 @@ void BezierApp::renderMenu() {
         ImGui::Text("Position écran: (%.0f, %.0f)", screenMouseX, screenMouseY);
         ImGui::Text("Mode de vue: %s", getViewModeString().c_str());
         ImGui::Text("Découpage: %s", enableClipping ? "Activé" : "Désactivé");
-        ImGui::Text("Algorithme: %s", usesSutherlandHodgman ? "Sutherland-Hodgman" : "Cyrus-Beck");
+        ImGui::Text("Algorithme: %s", getClippingAlgorithmString().c_str());
         ImGui::Text("Points fenêtre: %zu", clipWindow.size());
 
-        if (selectedCurveIterator != curves.end()) {
-            ImGui::Text("Points de contrôle: %d", selectedCurveIterator->getControlPointCount());
-            ImGui::Text("Pas: %.4f", selectedCurveIterator->getStep());
-            ImGui::Text("Méthode directe: %s", selectedCurveIterator->isShowingDirectMethod() ? "Oui" : "Non");
-            ImGui::Text("De Casteljau: %s", selectedCurveIterator->isShowingDeCasteljau() ? "Oui" : "Non");
+        if (curves.isValid(selectedCurve)) {
+            ImGui::Text("Points de contrôle: %d", curves.get(selectedCurve)->getControlPointCount());
+            ImGui::Text("Pas: %.4f", curves.get(selectedCurve)->getStep());
+            ImGui::Text("Méthode directe: %s", curves.get(selectedCurve)->isShowingDirectMethod() ? "Oui" : "Non");
+            ImGui::Text("De Casteljau: %s", curves.get(selectedCurve)->isShowingDeCasteljau() ? "Oui" : "Non");
+            ImGui::Text("Mémoire courbe: %.1f Ko", curves.get(selectedCurve)->getMemoryUsage() / 1024.0f);
+            if (curves.get(selectedCurve)->isCompactStorage()) {
+                ImGui::Text("Erreur de quantification: %.6f", curves.get(selectedCurve)->getQuantizationError());
+            }
+        }
+
+        ImGui::Text("Groupes: %zu", sceneGraph.getGroupCount());
+        if (curves.isValid(selectedCurve) && sceneGraph.groupOf(selectedCurve) != SceneGraph::ROOT) {
+            ImGui::Text("Groupe courant: %s", sceneGraph.getName(sceneGraph.groupOf(selectedCurve)).c_str());
+        }
+
+        if (!selectedCurves.empty()) {
+            ImGui::Text("Courbes sélectionnées: %zu", selectedCurves.size());
+            if (ImGui::Button("Appliquer les transformations")) {
+                bakeSelection();
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Reporte les matrices des courbes sélectionnées dans leurs points de contrôle");
+            }
+        }
+
+        if (!pointSelection.empty()) {
+            ImGui::Text("Points sélectionnés: %zu (%.1f Ko)", pointSelection.count(),
+                        pointSelection.memoryUsage() / 1024.0f);
+        }
+
+        // Raccordement de toutes les courbes (ou de la sélection) en une chaîne
+        const char* continuities[] = { "C0", "C1", "G1", "C2" };
+        int continuity = static_cast<int>(chainContinuity);
+        if (ImGui::Combo("Continuité", &continuity, continuities, 4)) {
+            chainContinuity = static_cast<CurveChain::Continuity>(continuity);
+        }
+        if (ImGui::Button("Raccorder la chaîne")) {
+            bridgeCurvesSequentially();
+        }
+
+        bool compact = compactStorage;
+        if (ImGui::Checkbox("Stockage compact", &compact)) {
+            setCompactStorage(compact);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Quantifie les points de contrôle sur 16 bits (les courbes modifiées repassent en flottant)");
+        }
+
+        if (ImGui::Button("Annuler") && history.canUndo()) {
+            undoEdit();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Rétablir") && history.canRedo()) {
+            redoEdit();
+        }
+        ImGui::SameLine();
+        ImGui::Text("%zu / %zu action(s), %.1f Ko", history.getUndoCount(), history.getRedoCount(),
+                    history.getMemoryUsage() / 1024.0f);
+        ImGui::Text("Événements d'entrée: %zu reçus, %zu traités (image courante)",
+                    inputStats.received, inputStats.processed);
+        if (droppedInputEvents > 0) {
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "Déplacements perdus: %zu", droppedInputEvents);
+        }
+
+        bool snapEnabled = snapEngine.isEnabled();
+        if (ImGui::Checkbox("Aimantation", &snapEnabled)) {
+            snapEngine.setEnabled(snapEnabled);
+        }
+        if (snapEnabled && ImGui::TreeNode("Cibles d'aimantation")) {
+            for (int i = 0; i < SnapEngine::TARGET_COUNT; i++) {
+                auto target = static_cast<SnapEngine::Target>(i);
+                ImGui::PushID(i);
+                bool on = snapEngine.isTargetEnabled(target);
+                if (ImGui::Checkbox(SnapEngine::getTargetName(target), &on)) {
+                    snapEngine.setTargetEnabled(target, on);
+                }
+                ImGui::SameLine(200);
+                int priority = snapEngine.getPriority(target);
+                ImGui::SetNextItemWidth(80);
+                if (ImGui::InputInt("Priorité", &priority)) {
+                    snapEngine.setPriority(target, priority);
+                }
+                ImGui::PopID();
+            }
+            float snapRadius = snapEngine.getRadius();
+            if (ImGui::SliderFloat("Rayon d'aimantation", &snapRadius, 0.005f, 0.1f, "%.3f")) {
+                snapEngine.setRadius(snapRadius);
+            }
+            float spacing = snapEngine.getGridSpacing();
+            if (ImGui::SliderFloat("Pas de la grille", &spacing, 0.01f, 0.5f, "%.2f")) {
+                snapEngine.setGridSpacing(spacing);
+            }
+            ImGui::Text("Dernière requête: %.4f ms", snapEngine.getLastQueryMs());
+            ImGui::TreePop();
+        }
+
+        if (ImGui::Button("Détecter les intersections")) {
+            detectAllIntersections();
+        }
+        if (intersectionStatsValid) {
+            const CurveIntersector::Stats& stats = curveIntersector.getStats();
+            ImGui::Text("Paires en intersection: %zu / %zu candidates", stats.intersectingPairs, stats.candidatePairs);
+            ImGui::Text("Enveloppes %.2f ms, balayage %.2f ms, tests %.2f ms (%d thread(s))",
+                        stats.prepareMs, stats.broadPhaseMs, stats.narrowPhaseMs, stats.threadCount);
+            ImGui::Text("Axes séparateurs réutilisés: %zu", stats.cachedAxes);
         }
 
         if (clipWindow.size() >= 3) {
-            ImGui::Text("Fenêtre convexe: %s",
-                        CyrusBeck::isPolygonConvex(clipWindow) ? "Oui" : "Non");
+            ImGui::Text("Fenêtre convexe: %s", clipWindow.isConvex() ? "Oui" : "Non");
+            if (clippingAlgorithm == BezierCurve::ClippingAlgorithm::SUTHERLAND_HODGMAN && clipBatchStats.curves > 0) {
+                ImGui::Text("Dernier lot Sutherland-Hodgman: %zu courbe(s), %zu points",
+                            clipBatchStats.curves, clipBatchStats.points);
+            }
         }
 
         // Slider pour ajuster la sensibilité de sélection des points
@@ -1093,6 +1584,15 @@ void BezierApp::renderExtrusionControls() {
             }
         }
 
+        ImGui::Checkbox("Retirer les boucles du profil", &cutProfileLoops);
+        if (curves.isValid(selectedCurve)) {
+            size_t loopCount = curves.get(selectedCurve)->getSelfIntersections().size();
+            if (loopCount > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "La courbe courante se recoupe (%zu boucle(s))",
+                                   loopCount);
+            }
+        }
+
         ImGui::Text("Surface: %s", surfaceGenerated ? "Générée" : "Non générée");
         if (surfaceGenerated) {
             ImGui::Text("Vertices: %zu", currentSurface.vertices.size());
@@ -1134,8 +1634,13 @@ void BezierApp::generateRuledSurfaceBridge() {
     curve1->calculateDirectMethod();
     curve2->calculateDirectMethod();
 
-    std::vector<Point> points1 = curve1->getDirectMethodPoints();
-    std::vector<Point> points2 = curve2->getDirectMethodPoints();
+    // L'extrusion travaille dans le repère de la scène
+    std::span<const Point> samples1 = curve1->getDirectMethodPoints();
+    std::span<const Point> samples2 = curve2->getDirectMethodPoints();
+    std::vector<Point> points1(samples1.begin(), samples1.end());
+    std::vector<Point> points2(samples2.begin(), samples2.end());
+    curve1->localToWorld(points1);
+    curve2->localToWorld(points2);
 
     if (points1.empty() || points2.empty()) return;
 
@@ -1186,27 +1691,39 @@ std::vector<Point> BezierApp::getCurvePointsFromCurve(const BezierCurve& curve)
     if (curve.getDirectMethodPoints().empty()) {
         const_cast<BezierCurve&>(curve).calculateDirectMethod();
     }
-    return curve.getDirectMethodPoints();
+
+    // L'extrusion travaille dans le repère de la scène
+    std::span<const Point> samples = curve.getDirectMethodPoints();
+    std::vector<Point> points(samples.begin(), samples.end());
+    curve.localToWorld(points);
+    return points;
 }
 
 void BezierApp::bridgeCurvesSequentially() {
-    if (curves.size() < 3) {
-        std::cout << "Need at least 3 curves to bridge" << std::endl;
-        return;
+    // La chaîne suit l'ordre de sélection, ou l'ordre des courbes sans sélection
+    std::vector<BezierCurve*> chainCurves;
+    if (selectedCurves.size() >= 2) {
+        for (CurveHandle handle : selectedCurves) {
+            chainCurves.push_back(curves.get(handle));
+        }
+    } else {
+        for (auto& curve : curves) {
+            chainCurves.push_back(&curve);
+        }
     }
 
-    // Get first 3 curves
-    auto it1 = curves.begin();
-    auto it2 = std::next(it1);
-    auto it3 = std::next(it2);
-
-    // Connect curve1 -> curve2 with C1 continuity
-    it1->joinC1(*it2);
+    if (chainCurves.size() < 2) {
+        std::cout << "Il faut au moins 2 courbes pour former une chaîne" << std::endl;
+        return;
+    }
 
-    // Connect curve2 -> curve3 with C1 continuity
-    it2->joinC1(*it3);
+    double start = glfwGetTime();
+    int modified = CurveChain(chainCurves).enforce(chainContinuity);
+    double elapsed = (glfwGetTime() - start) * 1000.0;
 
-    std::cout << "Bridged 3 curves sequentially with C1 continuity" << std::endl;
+    std::cout << "Chaîne de " << chainCurves.size() << " courbes raccordée en "
+              << CurveChain::getContinuityName(chainContinuity) << " (" << modified
+              << " courbe(s) modifiée(s), " << elapsed << " ms)" << std::endl;
 }
 
 void BezierApp::mouseButtonCallback(int button, int action, int mods) {
@@ -1235,35 +1752,59 @@ void BezierApp::mouseButtonCallback(int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
         switch (currentMode) {
             case Mode::ADD_CONTROL_POINTS:
-                if (selectedCurveIterator != curves.end()) {
-                    if (isPointHovered && hoveredPointIndex == 0) {
-                        selectedCurveIterator->closeCurve();
+                if (curves.isValid(selectedCurve)) {
+                    BezierCurve* curve = curves.get(selectedCurve);
+                    int count = curve->getControlPointCount();
+                    uint64_t previousVersion = curve->getVersion();
+                    if (isPointHovered && hoveredCurve == selectedCurve && hoveredPointIndex == 0) {
+                        curve->closeCurve();
                         std::cout << "Courbe fermée" << std::endl;
                     } else {
-                        selectedCurveIterator->addControlPoint(mouseX, mouseY);
+                        curve->addControlPoint(mouseX, mouseY);
                         std::cout << "Point de contrôle ajouté: (" << mouseX << ", " << mouseY << ")" << std::endl;
                     }
+                    if (curve->getControlPointCount() > count) {
+                        history.recordPointInsert(selectedCurve, count, curve->getControlPoint(count));
+                        updatePointGrid(selectedCurve, count, previousVersion);
+                    }
                 }
                 break;
 
             case Mode::EDIT_CONTROL_POINTS:
                 if (isPointHovered && hoveredPointIndex != -1) {
+                    if (hoveredCurve != selectedCurve && curves.isValid(hoveredCurve)) {
+                        selectedCurve = hoveredCurve;
+                        std::cout << "Courbe sélectionnée par son point de contrôle" << std::endl;
+                    }
                     selectedPointIndex = hoveredPointIndex;
                     std::cout << "Point de contrôle sélectionné: " << selectedPointIndex << std::endl;
+                } else if (mods & GLFW_MOD_CONTROL) {
+                    insertControlPointOnCurve(mouseX, mouseY);
                 } else {
                     selectNearestControlPoint(mouseX, mouseY);
+                    if (selectedPointIndex == -1) {
+                        // Clic sur le tracé d'une courbe : elle devient la courbe courante
+                        CurveHit hit;
+                        CurveHandle curve = pickCurveHit(mouseX, mouseY, hit, selectionPadding);
+                        if (curves.isValid(curve)) {
+                            selectedCurve = curve;
+                            std::cout << "Courbe sélectionnée (t = " << hit.t << ", distance " << hit.distance << ")" << std::endl;
+                        }
+                    }
                 }
+                history.beginDrag();
                 break;
 
             case Mode::CREATE_CLIP_WINDOW:
-                clipWindow.emplace_back(mouseX, mouseY);
+                clipWindow.addVertex(Point(mouseX, mouseY));
+                syncClipGrid(static_cast<int>(clipWindow.size()) - 1);
                 std::cout << "Point de fenêtre ajouté: (" << mouseX << ", " << mouseY << ")" << std::endl;
 
                 if (clipWindow.size() >= 3) {
-                    if (CyrusBeck::isPolygonConvex(clipWindow)) {
+                    if (clipWindow.isConvex()) {
                         std::cout << "La fenêtre est convexe." << std::endl;
                     } else {
-                        std::cout << "Attention: La fenêtre n'est pas convexe!" << std::endl;
+                        std::cout << "La fenêtre n'est pas convexe : découpage général (Greiner-Hormann)" << std::endl;
                     }
                 }
                 break;
@@ -1276,13 +1817,78 @@ void BezierApp::mouseButtonCallback(int button, int action, int mods) {
                     selectNearestClipPoint(mouseX, mouseY);
                 }
                 break;
+
+            case Mode::SELECT_CURVES:
+                // Le relâchement décide entre un clic et une sélection rectangulaire
+                isBoxSelecting = true;
+                boxSelectStart = Point(mouseX, mouseY);
+                break;
+
+            case Mode::SELECT_POINTS:
+                // Alt : lasso à main levée, sinon rectangle (ou clic sur un point)
+                if (mods & GLFW_MOD_ALT) {
+                    isLassoSelecting = true;
+                    lassoPoints.assign(1, Point(rawMouseX, rawMouseY));
+                } else {
+                    isBoxSelecting = true;
+                    boxSelectStart = Point(rawMouseX, rawMouseY);
+                }
+                break;
         }
     }
     else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE) {
         if (currentMode == Mode::EDIT_CONTROL_POINTS) {
             selectedPointIndex = -1;
+            history.endDrag();
         } else if (currentMode == Mode::EDIT_CLIP_WINDOW) {
             selectedClipPointIndex = -1;
+        } else if (currentMode == Mode::SELECT_CURVES && isBoxSelecting) {
+            isBoxSelecting = false;
+            bool shift = (mods & GLFW_MOD_SHIFT) != 0;
+
+            if (std::fabs(mouseX - boxSelectStart.x) > selectionPadding / 2 ||
+                std::fabs(mouseY - boxSelectStart.y) > selectionPadding / 2) {
+                selectCurvesInBox(boxSelectStart, Point(mouseX, mouseY), shift);
+            } else {
+                CurveHandle curve = pickCurve(mouseX, mouseY);
+                if (!shift) {
+                    clearCurveSelection();
+                }
+                if (curves.isValid(curve)) {
+                    selectCurve(curve, shift);
+                }
+            }
+            std::cout << "Courbes sélectionnées: " << selectedCurves.size() << std::endl;
+        } else if (currentMode == Mode::SELECT_POINTS && (isBoxSelecting || isLassoSelecting)) {
+            bool shift = (mods & GLFW_MOD_SHIFT) != 0;
+            Point release(rawMouseX, rawMouseY);
+
+            if (isLassoSelecting) {
+                isLassoSelecting = false;
+                lassoPoints.push_back(release);
+                if (lassoPoints.size() >= 3) {
+                    selectPointsInLasso(lassoPoints, shift);
+                } else if (!shift) {
+                    pointSelection.clear();
+                }
+                lassoPoints.clear();
+            } else {
+                isBoxSelecting = false;
+                if (std::fabs(release.x - boxSelectStart.x) > selectionPadding / 2 ||
+                    std::fabs(release.y - boxSelectStart.y) > selectionPadding / 2) {
+                    selectPointsInBox(boxSelectStart, release, shift);
+                } else {
+                    // Simple clic : le point survolé est sélectionné (Maj : basculé)
+                    if (!shift) {
+                        pointSelection.clear();
+                    }
+                    if (isPointHovered && curves.isValid(hoveredCurve)) {
+                        pointSelection.select(hoveredCurve, hoveredPointIndex,
+                                              !(shift && pointSelection.isSelected(hoveredCurve, hoveredPointIndex)));
+                    }
+                }
+            }
+            std::cout << "Points sélectionnés: " << pointSelection.count() << std::endl;
         }
     }
 }
@@ -1330,6 +1936,14 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
 
                 // === TOUCHES EXISTANTES ===
             case GLFW_KEY_A:
+                if ((mods & GLFW_MOD_CONTROL) && currentMode == Mode::SELECT_POINTS) {
+                    selectAllPoints();
+                    break;
+                }
+                if (mods & GLFW_MOD_CONTROL) {
+                    selectAllCurves();
+                    break;
+                }
                 currentMode = Mode::ADD_CONTROL_POINTS;
                 std::cout << "Mode: Ajout de points de contrôle" << std::endl;
                 break;
@@ -1349,28 +1963,28 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
                 break;
 
             case GLFW_KEY_EQUAL: // Touche '+'
-                if (selectedCurveIterator != curves.end()) {
-                    selectedCurveIterator->increaseStep();
+                if (curves.isValid(selectedCurve)) {
+                    curves.get(selectedCurve)->increaseStep();
                 }
                 break;
 
             case GLFW_KEY_MINUS: // Touche '-'
-                if (selectedCurveIterator != curves.end()) {
-                    selectedCurveIterator->decreaseStep();
+                if (curves.isValid(selectedCurve)) {
+                    curves.get(selectedCurve)->decreaseStep();
                 }
                 break;
 
             case GLFW_KEY_1:
-                if (selectedCurveIterator != curves.end()) {
+                if (curves.isValid(selectedCurve)) {
                     std::cout << "=== PRESSING KEY 1 DEBUG ===" << std::endl;
-                    std::cout << "Control points: " << selectedCurveIterator->getControlPointCount() << std::endl;
+                    std::cout << "Control points: " << curves.get(selectedCurve)->getControlPointCount() << std::endl;
 
-                    selectedCurveIterator->toggleDirectMethod();
+                    curves.get(selectedCurve)->toggleDirectMethod();
 
-                    std::cout << "After toggle - showing direct: " << selectedCurveIterator->isShowingDirectMethod() << std::endl;
+                    std::cout << "After toggle - showing direct: " << curves.get(selectedCurve)->isShowingDirectMethod() << std::endl;
 
                     // Check if points were calculated
-                    const auto& directPoints = selectedCurveIterator->getDirectMethodPoints();
+                    const auto& directPoints = curves.get(selectedCurve)->getDirectMethodPoints();
                     std::cout << "Direct method points count: " << directPoints.size() << std::endl;
 
                     if (directPoints.size() > 0) {
@@ -1382,14 +1996,14 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
                 break;
 
             case GLFW_KEY_2:
-                if (selectedCurveIterator != curves.end()) {
-                    selectedCurveIterator->toggleDeCasteljau();
+                if (curves.isValid(selectedCurve)) {
+                    curves.get(selectedCurve)->toggleDeCasteljau();
                 }
                 break;
 
             case GLFW_KEY_3:
-                if (selectedCurveIterator != curves.end()) {
-                    selectedCurveIterator->showBoth();
+                if (curves.isValid(selectedCurve)) {
+                    curves.get(selectedCurve)->showBoth();
                 }
                 break;
 
@@ -1397,26 +2011,79 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
                 nextCurve();
                 break;
 
+            case GLFW_KEY_J:
+                if (mods & GLFW_MOD_SHIFT) {
+                    currentMode = Mode::SELECT_POINTS;
+                    std::cout << "Mode: Sélection de points" << std::endl;
+                    break;
+                }
+                currentMode = Mode::SELECT_CURVES;
+                std::cout << "Mode: Sélection de courbes" << std::endl;
+                break;
+
+            case GLFW_KEY_I:
+                if (mods & GLFW_MOD_SHIFT) {
+                    detectAllIntersections();
+                } else if (curves.isValid(selectedCurve)) {
+                    printCurveIntersections(selectedCurve);
+                }
+                break;
+
+            case GLFW_KEY_K:
+                if (mods & GLFW_MOD_SHIFT) {
+                    ungroupCurrentCurve();
+                } else {
+                    groupSelection();
+                }
+                break;
+
             case GLFW_KEY_T:
-                if (selectedCurveIterator != curves.end()) {
+                if (currentMode == Mode::SELECT_POINTS && !pointSelection.empty()) {
+                    transformSelectedPoints(Affine2D::translation(0.1f, 0.1f));
+                } else if (!selectedCurves.empty()) {
+                    transformSelection(Affine2D::translation(0.1f, 0.1f));
+                } else if (sceneGraph.groupOf(selectedCurve) != SceneGraph::ROOT) {
+                    transformGroup(sceneGraph.groupOf(selectedCurve), Affine2D::translation(0.1f, 0.1f));
+                } else if (curves.isValid(selectedCurve)) {
                     float dx = 0.1f;
                     float dy = 0.1f;
-                    selectedCurveIterator->translate(dx, dy);
+                    Affine2D before = curves.get(selectedCurve)->getTransform();
+                    curves.get(selectedCurve)->translate(dx, dy);
+                    recordCurveTransform(selectedCurve, before);
                 }
                 break;
 
             case GLFW_KEY_S:
-                if (selectedCurveIterator != curves.end()) {
+                if (currentMode == Mode::SELECT_POINTS && !pointSelection.empty()) {
+                    transformSelectedPoints(Affine2D::about(Affine2D::scaling(1.1f, 1.1f), getPointSelectionCenter()));
+                } else if (!selectedCurves.empty()) {
+                    transformSelection(Affine2D::about(Affine2D::scaling(1.1f, 1.1f), getSelectionCenter()));
+                } else if (sceneGraph.groupOf(selectedCurve) != SceneGraph::ROOT) {
+                    transformGroup(sceneGraph.groupOf(selectedCurve), Affine2D::scaling(1.1f, 1.1f));
+                } else if (curves.isValid(selectedCurve)) {
                     float sx = 1.1f;
                     float sy = 1.1f;
-                    selectedCurveIterator->scale(sx, sy);
+                    Affine2D before = curves.get(selectedCurve)->getTransform();
+                    curves.get(selectedCurve)->scale(sx, sy);
+                    recordCurveTransform(selectedCurve, before);
                 }
                 break;
 
             case GLFW_KEY_R:
-                if (selectedCurveIterator != curves.end()) {
+                if (currentMode == Mode::SELECT_POINTS && !pointSelection.empty()) {
+                    float radians = 15.0f * M_PI / 180.0f;
+                    transformSelectedPoints(Affine2D::about(Affine2D::rotation(radians), getPointSelectionCenter()));
+                } else if (!selectedCurves.empty()) {
+                    float radians = 15.0f * M_PI / 180.0f;
+                    transformSelection(Affine2D::about(Affine2D::rotation(radians), getSelectionCenter()));
+                } else if (sceneGraph.groupOf(selectedCurve) != SceneGraph::ROOT) {
+                    float radians = 15.0f * M_PI / 180.0f;
+                    transformGroup(sceneGraph.groupOf(selectedCurve), Affine2D::rotation(radians));
+                } else if (curves.isValid(selectedCurve)) {
                     float angle = 15.0f;
-                    selectedCurveIterator->rotate(angle);
+                    Affine2D before = curves.get(selectedCurve)->getTransform();
+                    curves.get(selectedCurve)->rotate(angle);
+                    recordCurveTransform(selectedCurve, before);
                 }
                 break;
 
@@ -1426,6 +2093,11 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
                 break;
 
             case GLFW_KEY_G:
+                if (mods & GLFW_MOD_SHIFT) {
+                    snapEngine.setEnabled(!snapEngine.isEnabled());
+                    std::cout << "Aimantation: " << (snapEngine.isEnabled() ? "Activée" : "Désactivée") << std::endl;
+                    break;
+                }
                 currentMode = Mode::EDIT_CLIP_WINDOW;
                 std::cout << "Mode: Édition de la fenêtre de découpage" << std::endl;
                 break;
@@ -1436,7 +2108,21 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
                 break;
 
             case GLFW_KEY_Z:
-                toggleClippingAlgorithm();
+                if (mods & GLFW_MOD_CONTROL) {
+                    if (mods & GLFW_MOD_SHIFT) {
+                        redoEdit();
+                    } else {
+                        undoEdit();
+                    }
+                } else {
+                    toggleClippingAlgorithm();
+                }
+                break;
+
+            case GLFW_KEY_Y:
+                if (mods & GLFW_MOD_CONTROL) {
+                    redoEdit();
+                }
                 break;
             case GLFW_KEY_P:
                 saveCurvesToFile();
@@ -1448,12 +2134,17 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
 
 
             case GLFW_KEY_DELETE:
-                if (currentMode == Mode::EDIT_CLIP_WINDOW && selectedClipPointIndex != -1) {
-                    clipWindow.erase(clipWindow.begin() + selectedClipPointIndex);
+                if (currentMode == Mode::SELECT_POINTS && !pointSelection.empty()) {
+                    deleteSelectedPoints();
+                } else if (currentMode == Mode::EDIT_CLIP_WINDOW && selectedClipPointIndex != -1) {
+                    clipWindow.removeVertex(selectedClipPointIndex);
+                    syncClipGrid(selectedClipPointIndex);
                     selectedClipPointIndex = -1;
                     std::cout << "Point de fenêtre supprimé" << std::endl;
-                } else if (currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1 && selectedCurveIterator != curves.end()) {
-                    selectedCurveIterator->removeControlPoint(selectedPointIndex);
+                } else if (currentMode == Mode::EDIT_CONTROL_POINTS && selectedPointIndex != -1 && curves.isValid(selectedCurve)) {
+                    BezierCurve* curve = curves.get(selectedCurve);
+                    history.recordPointRemove(selectedCurve, selectedPointIndex, curve->getControlPoint(selectedPointIndex));
+                    curve->removeControlPoint(selectedPointIndex);
                     selectedPointIndex = -1;
                     std::cout << "Point de contrôle supprimé" << std::endl;
                 }
@@ -1469,8 +2160,8 @@ void BezierApp::keyCallback(int key, int scancode, int action, int mods) {
 }
 
 void BezierApp::generateLinearExtrusion() {
-    if (selectedCurveIterator == curves.end() ||
-        selectedCurveIterator->getControlPointCount() < 2) {
+    if (!curves.isValid(selectedCurve) ||
+        curves.get(selectedCurve)->getControlPointCount() < 2) {
         std::cout << "Pas assez de points de contrôle pour l'extrusion" << std::endl;
         return;
     }
@@ -1479,12 +2170,13 @@ void BezierApp::generateLinearExtrusion() {
     currentSurface.indices.clear();
 
     // Obtenir les points de la courbe 2D
-    std::vector<Point> curvePoints = getCurvePoints(*selectedCurveIterator);
+    std::vector<Point> curvePoints = getCurvePoints(*curves.get(selectedCurve));
 
     if (curvePoints.empty()) {
         std::cout << "Aucun point de courbe calculé" << std::endl;
         return;
     }
+    checkProfileLoops(*curves.get(selectedCurve), curvePoints, "Profil");
 
     // Générer les vertices pour l'extrusion linéaire
     int curvePointCount = curvePoints.size();
@@ -1536,8 +2228,8 @@ void BezierApp::generateLinearExtrusion() {
 }
 
 void BezierApp::generateRevolutionExtrusion() {
-    if (selectedCurveIterator == curves.end() ||
-        selectedCurveIterator->getControlPointCount() < 2) {
+    if (!curves.isValid(selectedCurve) ||
+        curves.get(selectedCurve)->getControlPointCount() < 2) {
         std::cout << "Pas assez de points de contrôle pour l'extrusion" << std::endl;
         return;
     }
@@ -1546,12 +2238,13 @@ void BezierApp::generateRevolutionExtrusion() {
     currentSurface.indices.clear();
 
     // Obtenir les points de la courbe 2D
-    std::vector<Point> curvePoints = getCurvePoints(*selectedCurveIterator);
+    std::vector<Point> curvePoints = getCurvePoints(*curves.get(selectedCurve));
 
     if (curvePoints.empty()) {
         std::cout << "Aucun point de courbe calculé" << std::endl;
         return;
     }
+    checkProfileLoops(*curves.get(selectedCurve), curvePoints, "Profil");
 
     int curvePointCount = curvePoints.size();
 
@@ -1633,6 +2326,8 @@ void BezierApp::generateGeneralizedExtrusion() {
         std::cout << "Les courbes doivent avoir des points calculés" << std::endl;
         return;
     }
+    checkProfileLoops(*formeCurve, forme, "Forme");
+    checkProfileLoops(*trajectoireCurve, trajectoire, "Trajectoire");
 
     int formeSize = forme.size();
     int trajectoireSize = trajectoire.size();
@@ -1745,13 +2440,17 @@ void BezierApp::loadCurvesFromFile() {
     if (file.is_open()) {
         std::string line;
         std::vector<std::tuple<float, float>> curveData;
+        clearCurveSelection();
+        pointSelection.clear();
+        sceneGraph.clear();
         curves.clear();
+        // Les entrées de l'historique désignent des courbes qui n'existent plus
+        history.clear();
 
         while (std::getline(file, line)) {
             if (line == ";") {
                 // Create a new curve and add points to it
-                curves.emplace_back();  // Add a new curve to the container
-                auto curveIter = --curves.end();  // Get iterator to the newly added curve
+                BezierCurve* curveIter = curves.get(curves.create());  // Add a new curve to the store
 
                 for (const auto& point : curveData) {
                     curveIter->addControlPoint(std::get<0>(point), std::get<1>(point));
@@ -1768,8 +2467,7 @@ void BezierApp::loadCurvesFromFile() {
 
         // Handle any remaining points (for the last curve if no ";" at the end)
         if (!curveData.empty()) {
-            curves.emplace_back();  // Add a new curve
-            auto curveIter = --curves.end();
+            BezierCurve* curveIter = curves.get(curves.create());  // Add a new curve
 
             for (const auto& point : curveData) {
                 curveIter->addControlPoint(std::get<0>(point), std::get<1>(point));
@@ -1778,7 +2476,11 @@ void BezierApp::loadCurvesFromFile() {
 
         // Set the selected curve to the first one if any were loaded
         if (!curves.empty()) {
-            selectedCurveIterator = curves.begin();
+            selectedCurve = curves.handleAt(0);
+        }
+
+        if (compactStorage) {
+            setCompactStorage(true);
         }
 
         file.close();
@@ -1788,6 +2490,64 @@ void BezierApp::loadCurvesFromFile() {
     }
 }
 
+void BezierApp::setCompactStorage(bool enabled) {
+    compactStorage = enabled;
+
+    size_t bytesBefore = 0, bytesAfter = 0;
+    float maxError = 0.0f;
+    for (auto& curve : curves) {
+        bytesBefore += curve.getMemoryUsage();
+        curve.setCompactStorage(enabled);
+        bytesAfter += curve.getMemoryUsage();
+        maxError = std::max(maxError, curve.getQuantizationError());
+    }
+
+    std::cout << "Stockage compact: " << (enabled ? "Activé" : "Désactivé")
+              << " (" << bytesBefore / 1024 << " Ko -> " << bytesAfter / 1024 << " Ko";
+    if (enabled) {
+        std::cout << ", erreur max: " << maxError;
+    }
+    std::cout << ")" << std::endl;
+}
+
+bool BezierApp::checkProfileLoops(const BezierCurve& curve, std::vector<Point>& profile, const char* role) const {
+    std::vector<SelfIntersection> loops = curve.getSelfIntersections();
+    if (loops.empty()) {
+        return false;
+    }
+
+    std::cout << "Attention : " << role << " avec " << loops.size()
+              << " boucle(s), la surface générée se recoupera" << std::endl;
+    for (const auto& loop : loops) {
+        std::cout << "  boucle t = [" << loop.tStart << ", " << loop.tEnd << "]" << std::endl;
+    }
+    if (!cutProfileLoops || profile.size() < 2) {
+        return true;
+    }
+
+    // Échantillons uniformes en t : retirer ceux de chaque boucle et les remplacer par le point
+    // de croisement (les boucles imbriquées dans une boucle déjà retirée sont ignorées)
+    const float last = static_cast<float>(profile.size() - 1);
+    std::vector<Point> simple;
+    simple.reserve(profile.size());
+    size_t next = 0;
+    for (const auto& loop : loops) {
+        size_t first = static_cast<size_t>(std::ceil(loop.tStart * last));
+        size_t end = static_cast<size_t>(std::floor(loop.tEnd * last));
+        if (first < next || end < first) {
+            continue;
+        }
+        simple.insert(simple.end(), profile.begin() + next, profile.begin() + first);
+        simple.push_back(loop.point);
+        next = end + 1;
+    }
+    simple.insert(simple.end(), profile.begin() + std::min(next, profile.size()), profile.end());
+
+    std::cout << "  boucles retirées : " << profile.size() - simple.size() << " échantillon(s) en moins" << std::endl;
+    profile.swap(simple);
+    return true;
+}
+
 std::vector<Point> BezierApp::getCurvePoints(const BezierCurve& curve) const {
     std::vector<Point> points;
 
@@ -1813,9 +2573,10 @@ std::vector<Point> BezierApp::getCurvePoints(const BezierCurve& curve) const {
         const auto& directPoints = curve.getDirectMethodPoints();
         std::cout << "Direct method points count: " << directPoints.size() << std::endl;
         if (!directPoints.empty()) {
-            points = directPoints;
+            points.assign(directPoints.begin(), directPoints.end());
             std::cout << "Using direct method points" << std::endl;
             std::cout << "=========================" << std::endl;
+            curve.localToWorld(points); // Échantillons dans le repère local de la courbe
             return points;
         }
     }
@@ -1824,9 +2585,10 @@ std::vector<Point> BezierApp::getCurvePoints(const BezierCurve& curve) const {
         const auto& deCasteljauPoints = curve.getDeCasteljauPoints();
         std::cout << "De Casteljau points count: " << deCasteljauPoints.size() << std::endl;
         if (!deCasteljauPoints.empty()) {
-            points = deCasteljauPoints;
+            points.assign(deCasteljauPoints.begin(), deCasteljauPoints.end());
             std::cout << "Using De Casteljau points" << std::endl;
             std::cout << "=========================" << std::endl;
+            curve.localToWorld(points); // Échantillons dans le repère local de la courbe
             return points;
         }
     }
@@ -1841,7 +2603,7 @@ std::vector<Point> BezierApp::getCurvePoints(const BezierCurve& curve) const {
     std::cout << "After forced calculation, points count: " << directPoints.size() << std::endl;
 
     if (!directPoints.empty()) {
-        points = directPoints;
+        points.assign(directPoints.begin(), directPoints.end());
         std::cout << "Using forced calculated points" << std::endl;
 
         // Print first few points for verification
@@ -1853,6 +2615,7 @@ std::vector<Point> BezierApp::getCurvePoints(const BezierCurve& curve) const {
     }
 
     std::cout << "=========================" << std::endl;
+    curve.localToWorld(points); // Échantillons dans le repère local de la courbe
     return points;
 }
 
@@ -1889,13 +2652,11 @@ void BezierApp::calculateSurfaceNormals() {
 }
 
 void BezierApp::createNewCurve() {
-    curves.emplace_back();
+    selectedCurve = curves.create();
 
-    curves.back().setClippingAlgorithm(usesSutherlandHodgman ?
-                                       BezierCurve::ClippingAlgorithm::SUTHERLAND_HODGMAN :
-                                       BezierCurve::ClippingAlgorithm::CYRUS_BECK);
+    curves.get(selectedCurve)->setClippingAlgorithm(clippingAlgorithm);
+    history.recordCurveCreate(selectedCurve);
 
-    selectedCurveIterator = std::prev(curves.end());
     selectedPointIndex = -1;
 
     std::cout << "Nouvelle courbe créée. Total: " << curves.size() << std::endl;
@@ -1907,19 +2668,22 @@ void BezierApp::deleteCurve() {
         return;
     }
 
-    if (selectedCurveIterator != curves.end()) {
-        auto nextIterator = std::next(selectedCurveIterator);
-        if (nextIterator == curves.end()) {
-            nextIterator = curves.begin();
-        }
+    if (curves.isValid(selectedCurve)) {
+        selectedCurves.erase(std::remove(selectedCurves.begin(), selectedCurves.end(), selectedCurve),
+                             selectedCurves.end());
+        setCurveMark(selectedCurve, false);
+        history.recordCurveDelete(selectedCurve, curves, sceneGraph.groupOf(selectedCurve));
+        sceneGraph.removeCurve(selectedCurve);
 
-        curves.erase(selectedCurveIterator);
+        // La courbe suivante prend la place de la courbe supprimée
+        size_t denseIndex = curves.denseIndexOf(selectedCurve);
+        curves.remove(selectedCurve);
 
         if (curves.empty()) {
-            selectedCurveIterator = curves.end();
+            selectedCurve = CurveHandle();
             std::cout << "Toutes les courbes ont été supprimées" << std::endl;
         } else {
-            selectedCurveIterator = nextIterator;
+            selectedCurve = curves.handleAt(denseIndex < curves.size() ? denseIndex : 0);
             std::cout << "Courbe supprimée. Courbe suivante sélectionnée." << std::endl;
         }
     }
@@ -1931,32 +2695,28 @@ void BezierApp::nextCurve() {
         return;
     }
 
-    if (selectedCurveIterator == curves.end()) {
-        selectedCurveIterator = curves.begin();
+    if (!curves.isValid(selectedCurve)) {
+        selectedCurve = curves.handleAt(0);
     } else {
-        selectedCurveIterator++;
-        if (selectedCurveIterator == curves.end()) {
-            selectedCurveIterator = curves.begin();
-        }
+        size_t denseIndex = curves.get(selectedCurve) - &curves[0];
+        selectedCurve = curves.handleAt((denseIndex + 1) % curves.size());
     }
 
     std::cout << "Courbe suivante sélectionnée" << std::endl;
 }
 
 void BezierApp::selectNearestControlPoint(float x, float y) {
-    if (selectedCurveIterator == curves.end()) return;
+    if (!curves.isValid(selectedCurve)) return;
 
-    float minDistance = selectionPadding * 2;
     selectedPointIndex = -1;
 
-    for (int i = 0; i < selectedCurveIterator->getControlPointCount(); i++) {
-        Point p = selectedCurveIterator->getControlPoint(i);
-        float distance = std::sqrt((p.x - x) * (p.x - x) + (p.y - y) * (p.y - y));
-
-        if (distance < minDistance) {
-            minDistance = distance;
-            selectedPointIndex = i;
-        }
+    syncPointGrid();
+    uint32_t selectedSlot = selectedCurve.index;
+    uint64_t id;
+    if (pointGrid.findNearest(Point(x, y), selectionPadding * 2, id, [selectedSlot](uint64_t candidate) {
+            return !(candidate & CLIP_POINT_TAG) && (candidate >> 32) == selectedSlot;
+        })) {
+        selectedPointIndex = static_cast<int>(id & 0xFFFFFFFFu);
     }
 
     if (selectedPointIndex != -1) {
@@ -1970,17 +2730,12 @@ void BezierApp::selectNearestClipPoint(float x, float y) {
         return;
     }
 
-    float minDistance = selectionPadding * 2;
     selectedClipPointIndex = -1;
 
-    for (int i = 0; i < clipWindow.size(); i++) {
-        Point p = clipWindow[i];
-        float distance = std::sqrt((p.x - x) * (p.x - x) + (p.y - y) * (p.y - y));
-
-        if (distance < minDistance) {
-            minDistance = distance;
-            selectedClipPointIndex = i;
-        }
+    uint64_t id;
+    if (pointGrid.findNearest(Point(x, y), selectionPadding * 2, id,
+                              [](uint64_t candidate) { return (candidate & CLIP_POINT_TAG) != 0; })) {
+        selectedClipPointIndex = static_cast<int>(id & ~CLIP_POINT_TAG);
     }
 
     if (selectedClipPointIndex != -1) {
@@ -1990,11 +2745,699 @@ void BezierApp::selectNearestClipPoint(float x, float y) {
 
 void BezierApp::clearClipWindow() {
     clipWindow.clear();
+    syncClipGrid(0);
     selectedClipPointIndex = -1;
     hoveredClipPointIndex = -1;
     std::cout << "Fenêtre de découpage effacée" << std::endl;
 }
 
+// === MULTI-SÉLECTION ===
+CurveHandle BezierApp::pickCurveHit(float x, float y, CurveHit& hit, float radius, CurveHandle exclude) {
+    // Hiérarchie de la scène pour les courbes proches du clic, puis hiérarchie des segments
+    // de chaque candidate
+    std::vector<CurveHandle> candidates = queryCurvesInBox(Point(x - radius, y - radius),
+                                                           Point(x + radius, y + radius));
+    CurveHandle nearest;
+    for (CurveHandle handle : candidates) {
+        if (handle == exclude) {
+            continue;
+        }
+        CurveHit candidate;
+        if (curves.get(handle)->pick(Point(x, y), radius, candidate)) {
+            radius = candidate.distance;
+            hit = candidate;
+            nearest = handle;
+        }
+    }
+    return nearest;
+}
+
+void BezierApp::insertControlPointOnCurve(float x, float y) {
+    CurveHit hit;
+    CurveHandle handle = pickCurveHit(x, y, hit, selectionPadding);
+    if (!curves.isValid(handle)) {
+        std::cout << "Aucune courbe sous le curseur" << std::endl;
+        return;
+    }
+
+    // Le point est inséré entre les deux points de contrôle dont l'intervalle de paramètre
+    // contient t, à la position cliquée sur la courbe
+    BezierCurve* curve = curves.get(handle);
+    int segments = curve->getControlPointCount() - 1;
+    int index = std::min(segments - 1, static_cast<int>(hit.t * segments)) + 1;
+    curve->insertControlPoint(index, hit.point.x, hit.point.y);
+    history.recordPointInsert(handle, index, hit.point);
+
+    // Le point inséré peut être glissé immédiatement
+    selectedCurve = handle;
+    selectedPointIndex = index;
+    std::cout << "Point de contrôle inséré à l'indice " << index << " (t = " << hit.t << ")" << std::endl;
+
+    if (realTimeExtrusion && surfaceGenerated && currentViewMode != ViewMode::VIEW_2D) {
+        needsExtrusionUpdate = true;
+    }
+}
+
+CurveHandle BezierApp::pickCurve(float x, float y) {
+    CurveHit hit;
+    CurveHandle picked = pickCurveHit(x, y, hit, selectionPadding);
+    if (curves.isValid(picked)) {
+        return picked;
+    }
+
+    // Courbes sans tracé (moins de deux points) : point de contrôle le plus proche
+    std::vector<CurveHandle> candidates = queryCurvesInBox(Point(x - selectionPadding, y - selectionPadding),
+                                                           Point(x + selectionPadding, y + selectionPadding));
+    CurveHandle nearest;
+    float minDistance = std::numeric_limits<float>::max();
+    for (CurveHandle handle : candidates) {
+        const BezierCurve* curve = curves.get(handle);
+        int index = curve->getNearestControlPoint(x, y);
+        float distance = curve->distanceToControlPoint(index, x, y);
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearest = handle;
+        }
+    }
+
+    return nearest;
+}
+
+void BezierApp::selectCurve(CurveHandle curve, bool toggle) {
+    if (isCurveSelected(curve)) {
+        if (toggle) {
+            selectedCurves.erase(std::find(selectedCurves.begin(), selectedCurves.end(), curve));
+            setCurveMark(curve, false);
+        }
+        return;
+    }
+    selectedCurves.push_back(curve);
+    setCurveMark(curve, true);
+
+    // La dernière courbe sélectionnée devient la courbe courante
+    selectedCurve = curve;
+    selectedPointIndex = -1;
+}
+
+void BezierApp::selectCurvesInBox(const Point& corner1, const Point& corner2, bool additive) {
+    if (!additive) {
+        clearCurveSelection();
+    }
+
+    float minX = std::min(corner1.x, corner2.x), maxX = std::max(corner1.x, corner2.x);
+    float minY = std::min(corner1.y, corner2.y), maxY = std::max(corner1.y, corner2.y);
+
+    // Sélectionner les courbes dont la boîte englobante touche le rectangle
+    for (CurveHandle handle : queryCurvesInBox(Point(minX, minY), Point(maxX, maxY))) {
+        if (!isCurveSelected(handle)) {
+            selectedCurves.push_back(handle);
+            setCurveMark(handle, true);
+        }
+    }
+}
+
+void BezierApp::selectAllCurves() {
+    clearCurveSelection();
+    selectedCurves.reserve(curves.size());
+    for (size_t i = 0; i < curves.size(); i++) {
+        selectedCurves.push_back(curves.handleAt(i));
+        setCurveMark(curves.handleAt(i), true);
+    }
+    std::cout << "Toutes les courbes sélectionnées: " << selectedCurves.size() << std::endl;
+}
+
+void BezierApp::clearCurveSelection() {
+    // Seuls les emplacements marqués sont remis à zéro
+    for (CurveHandle handle : selectedCurves) {
+        setCurveMark(handle, false);
+    }
+    selectedCurves.clear();
+}
+
+bool BezierApp::isCurveSelected(CurveHandle curve) const {
+    return curve.index < selectedCurveMarks.size() && selectedCurveMarks[curve.index] == curve.generation + 1;
+}
+
+void BezierApp::setCurveMark(CurveHandle curve, bool selected) {
+    if (curve.index >= selectedCurveMarks.size()) {
+        if (!selected) {
+            return;
+        }
+        selectedCurveMarks.resize(curve.index + 1, 0);
+    }
+    if (selected) {
+        selectedCurveMarks[curve.index] = curve.generation + 1;
+    } else if (selectedCurveMarks[curve.index] == curve.generation + 1) {
+        selectedCurveMarks[curve.index] = 0;
+    }
+}
+
+Point BezierApp::getSelectionCenter() const {
+    // Centre de la boîte englobante de la sélection, pivot commun des transformations
+    bool first = true;
+    Point selectionMin, selectionMax;
+    for (CurveHandle handle : selectedCurves) {
+        const BezierCurve* curve = curves.get(handle);
+        Point minPoint, maxPoint;
+        if (!curve || !curve->getBounds(minPoint, maxPoint)) continue;
+
+        if (first) {
+            selectionMin = minPoint;
+            selectionMax = maxPoint;
+            first = false;
+        } else {
+            selectionMin.x = std::min(selectionMin.x, minPoint.x);
+            selectionMin.y = std::min(selectionMin.y, minPoint.y);
+            selectionMax.x = std::max(selectionMax.x, maxPoint.x);
+            selectionMax.y = std::max(selectionMax.y, maxPoint.y);
+        }
+    }
+    return Point((selectionMin.x + selectionMax.x) * 0.5f, (selectionMin.y + selectionMax.y) * 0.5f);
+}
+
+void BezierApp::transformSelection(const Affine2D& m) {
+    // Une seule composition de matrice par courbe : ni recalcul ni transfert de points,
+    // le vertex shader applique la transformation au prochain dessin
+    for (CurveHandle handle : selectedCurves) {
+        if (BezierCurve* curve = curves.get(handle)) {
+            curve->applyTransform(m);
+        }
+    }
+    history.recordTransform(selectedCurves, m);
+
+    if (realTimeExtrusion && surfaceGenerated && currentViewMode != ViewMode::VIEW_2D) {
+        needsExtrusionUpdate = true;
+    }
+}
+
+void BezierApp::bakeSelection() {
+    // Chaque courbe reporte sa matrice en une passe sur ses points ; les recalculs et
+    // transferts sont regroupés dans flushCurveUpdates()
+    for (CurveHandle handle : selectedCurves) {
+        if (BezierCurve* curve = curves.get(handle)) {
+            curve->bakeTransform();
+        }
+    }
+    std::cout << "Transformations appliquées à " << selectedCurves.size() << " courbe(s)" << std::endl;
+}
+
+// === SÉLECTION DE POINTS ===
+void BezierApp::selectPoints(const AABB& area, const std::function<bool(const Point&)>& inside,
+                             const std::function<bool(const AABB&)>& containsBox, bool additive) {
+    if (!additive) {
+        pointSelection.clear();
+    }
+
+    // Seules les courbes dont la boîte touche la zone sont parcourues ; une courbe dont tous
+    // les points tiennent dans une partie entièrement intérieure est sélectionnée d'un bloc
+    for (CurveHandle handle : queryCurvesInBox(area.min, area.max)) {
+        const BezierCurve* curve = curves.get(handle);
+        int count = curve->getControlPointCount();
+        Point minPoint, maxPoint;
+        if (curve->getBounds(minPoint, maxPoint) && containsBox(AABB(minPoint, maxPoint))) {
+            pointSelection.selectAll(handle, count);
+            continue;
+        }
+        for (int i = 0; i < count; i++) {
+            Point p = curve->getControlPoint(i);
+            if (area.contains(p) && inside(p)) {
+                pointSelection.select(handle, i);
+            }
+        }
+    }
+}
+
+void BezierApp::selectPointsInBox(const Point& corner1, const Point& corner2, bool additive) {
+    AABB box(Point(std::min(corner1.x, corner2.x), std::min(corner1.y, corner2.y)),
+             Point(std::max(corner1.x, corner2.x), std::max(corner1.y, corner2.y)));
+    selectPoints(box, [](const Point&) { return true; },
+                 [&box](const AABB& bounds) { return box.contains(bounds); }, additive);
+}
+
+void BezierApp::selectPointsInLasso(const std::vector<Point>& polygon, bool additive) {
+    // Le lasso est rastérisé une fois ; chaque point coûte ensuite un accès à la grille
+    lassoMask.build(polygon);
+    selectPoints(lassoMask.getBounds(), [this](const Point& p) { return lassoMask.contains(p); },
+                 [this](const AABB& bounds) { return lassoMask.containsBox(bounds); }, additive);
+}
+
+void BezierApp::selectAllPoints() {
+    pointSelection.clear();
+    for (size_t i = 0; i < curves.size(); i++) {
+        pointSelection.selectAll(curves.handleAt(i), curves[i].getControlPointCount());
+    }
+    std::cout << "Tous les points sélectionnés: " << pointSelection.count() << std::endl;
+}
+
+Point BezierApp::getPointSelectionCenter() {
+    // Centre de la boîte englobante des points sélectionnés
+    pointSelection.prune(curves);
+    bool first = true;
+    AABB box;
+    for (CurveHandle handle : pointSelection.getCurves()) {
+        const BezierCurve* curve = curves.get(handle);
+        for (int i : pointSelection.getIndices(handle)) {
+            Point p = curve->getControlPoint(i);
+            if (first) {
+                box = AABB(p, p);
+                first = false;
+            } else {
+                box = box.merged(AABB(p, p));
+            }
+        }
+    }
+    return box.center();
+}
+
+void BezierApp::transformSelectedPoints(const Affine2D& m) {
+    // Une réécriture des points par courbe (recalcul différé) et une entrée d'historique
+    // par courbe, annulées ensemble
+    pointSelection.prune(curves);
+    history.beginGroup();
+    for (CurveHandle handle : pointSelection.getCurves()) {
+        BezierCurve* curve = curves.get(handle);
+        std::vector<Point> points(curve->getControlPointCount());
+        for (size_t i = 0; i < points.size(); i++) {
+            points[i] = curve->getControlPoint(static_cast<int>(i));
+        }
+        std::vector<int> indices = pointSelection.getIndices(handle);
+        for (int i : indices) {
+            points[i] = m.apply(points[i]);
+        }
+        curve->setControlPoints(points);
+        history.recordPointsTransform(handle, std::move(indices), m);
+    }
+    history.endGroup();
+
+    if (realTimeExtrusion && surfaceGenerated && currentViewMode != ViewMode::VIEW_2D) {
+        needsExtrusionUpdate = true;
+    }
+}
+
+void BezierApp::deleteSelectedPoints() {
+    pointSelection.prune(curves);
+    size_t removed = pointSelection.count();
+    history.beginGroup();
+    for (CurveHandle handle : pointSelection.getCurves()) {
+        BezierCurve* curve = curves.get(handle);
+        std::vector<int> indices = pointSelection.getIndices(handle);
+        std::vector<Point> kept, points;
+        kept.reserve(curve->getControlPointCount() - indices.size());
+        points.reserve(indices.size());
+
+        size_t k = 0;
+        for (int i = 0; i < curve->getControlPointCount(); i++) {
+            if (k < indices.size() && indices[k] == i) {
+                points.push_back(curve->getControlPoint(i));
+                k++;
+            } else {
+                kept.push_back(curve->getControlPoint(i));
+            }
+        }
+        curve->setControlPoints(kept);
+        history.recordPointsRemove(handle, std::move(indices), std::move(points));
+    }
+    history.endGroup();
+
+    pointSelection.clear();
+    selectedPointIndex = -1;
+    std::cout << removed << " point(s) de contrôle supprimé(s)" << std::endl;
+}
+
+void BezierApp::renderPointSelection() {
+    if (currentMode != Mode::SELECT_POINTS || (pointSelection.empty() && !isLassoSelecting)) {
+        return;
+    }
+
+    // Points sélectionnés et lasso en cours dans un seul buffer
+    pointSelection.prune(curves);
+    std::vector<Point> vertices;
+    vertices.reserve(pointSelection.count() + lassoPoints.size() + 1);
+    for (CurveHandle handle : pointSelection.getCurves()) {
+        const BezierCurve* curve = curves.get(handle);
+        for (int i : pointSelection.getIndices(handle)) {
+            vertices.push_back(curve->getControlPoint(i));
+        }
+    }
+    size_t selectedCount = vertices.size();
+    if (isLassoSelecting) {
+        vertices.insert(vertices.end(), lassoPoints.begin(), lassoPoints.end());
+        vertices.emplace_back(rawMouseX, rawMouseY);
+    }
+
+    static GLuint pointSelectionVAO = 0, pointSelectionVBO = 0;
+    if (pointSelectionVAO == 0) {
+        glGenVertexArrays(1, &pointSelectionVAO);
+        glGenBuffers(1, &pointSelectionVBO);
+        glBindVertexArray(pointSelectionVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, pointSelectionVBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+    }
+
+    shader->Begin();
+    glBindVertexArray(pointSelectionVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, pointSelectionVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Point), vertices.data(), GL_STREAM_DRAW);
+
+    if (selectedCount > 0) {
+        shader->SetUniform("color", 1.0f, 0.6f, 0.0f); // Orange
+        glPointSize(7.0f);
+        glDrawArrays(GL_POINTS, 0, selectedCount);
+        glPointSize(5.0f);
+    }
+    if (vertices.size() > selectedCount) {
+        shader->SetUniform("color", 0.6f, 0.6f, 1.0f);
+        glDrawArrays(GL_LINE_LOOP, selectedCount, vertices.size() - selectedCount);
+    }
+
+    glBindVertexArray(0);
+    shader->End();
+}
+
+// === GROUPES ===
+void BezierApp::groupSelection() {
+    if (selectedCurves.empty()) {
+        std::cout << "Aucune courbe sélectionnée à grouper" << std::endl;
+        return;
+    }
+
+    // Si toutes les courbes appartiennent au même groupe, le nouveau groupe y est imbriqué
+    SceneGraph::GroupId parent = sceneGraph.groupOf(selectedCurves.front());
+    for (CurveHandle handle : selectedCurves) {
+        if (sceneGraph.groupOf(handle) != parent) {
+            parent = SceneGraph::ROOT;
+            break;
+        }
+    }
+
+    SceneGraph::GroupId group = sceneGraph.createGroup(parent);
+    for (CurveHandle handle : selectedCurves) {
+        sceneGraph.addCurve(group, handle, curves);
+    }
+
+    std::cout << sceneGraph.getName(group) << " créé avec " << selectedCurves.size() << " courbe(s)" << std::endl;
+}
+
+void BezierApp::ungroupCurrentCurve() {
+    SceneGraph::GroupId group = sceneGraph.groupOf(selectedCurve);
+    if (group == SceneGraph::ROOT) {
+        std::cout << "La courbe courante n'appartient à aucun groupe" << std::endl;
+        return;
+    }
+
+    std::cout << sceneGraph.getName(group) << " dissous" << std::endl;
+    sceneGraph.removeGroup(group, curves);
+}
+
+void BezierApp::transformGroup(SceneGraph::GroupId group, const Affine2D& m) {
+    // Transformation autour du centre du groupe, propagée aux sous-groupes par update()
+    Point minPoint, maxPoint;
+    if (!sceneGraph.getBounds(group, curves, minPoint, maxPoint)) {
+        return;
+    }
+    Point center((minPoint.x + maxPoint.x) * 0.5f, (minPoint.y + maxPoint.y) * 0.5f);
+    Affine2D before = sceneGraph.getLocalTransform(group);
+    sceneGraph.applyWorldTransform(group, Affine2D::about(m, center));
+    // Écart exprimé dans le repère du parent : l'annulation n'a pas besoin de la matrice monde
+    history.recordGroupTransform(group, sceneGraph.getLocalTransform(group) * before.inverse());
+}
+
+void BezierApp::recordCurveTransform(CurveHandle handle, const Affine2D& before) {
+    history.recordTransform({handle}, curves.get(handle)->getTransform() * before.inverse());
+}
+
+void BezierApp::undoEdit() {
+    if (!history.undo(curves, sceneGraph)) {
+        std::cout << "Rien à annuler" << std::endl;
+        return;
+    }
+    afterHistoryChange();
+    std::cout << "Action annulée (" << history.getUndoCount() << " restante(s))" << std::endl;
+}
+
+void BezierApp::redoEdit() {
+    if (!history.redo(curves, sceneGraph)) {
+        std::cout << "Rien à rétablir" << std::endl;
+        return;
+    }
+    afterHistoryChange();
+    std::cout << "Action rétablie (" << history.getRedoCount() << " restante(s))" << std::endl;
+}
+
+void BezierApp::afterHistoryChange() {
+    // Une courbe a pu être supprimée ou recréée : la sélection ne garde que des poignées valides
+    selectedCurves.erase(std::remove_if(selectedCurves.begin(), selectedCurves.end(),
+                                        [this](CurveHandle h) {
+                                            if (curves.isValid(h)) {
+                                                return false;
+                                            }
+                                            setCurveMark(h, false);
+                                            return true;
+                                        }),
+                         selectedCurves.end());
+    pointSelection.prune(curves);
+    if (curves.isValid(history.getLastCurve())) {
+        selectedCurve = history.getLastCurve();
+    } else if (!curves.isValid(selectedCurve)) {
+        selectedCurve = curves.empty() ? CurveHandle() : curves.handleAt(curves.size() - 1);
+    }
+    selectedPointIndex = -1;
+
+    if (realTimeExtrusion && surfaceGenerated && currentViewMode != ViewMode::VIEW_2D) {
+        needsExtrusionUpdate = true;
+    }
+}
+
+void BezierApp::flushCurveUpdates() {
+    for (auto& curve : curves) {
+        if (curve.hasPendingUpdate()) {
+            curve.flushPendingUpdate();
+        }
+    }
+}
+
+// === HIÉRARCHIE DE BOÎTES ENGLOBANTES ===
+void BezierApp::syncCurveIndexes() {
+    // Seul lecteur du journal du CurveStore : l'arbre des courbes et la grille des points ne
+    // reprennent que les courbes créées, modifiées ou supprimées depuis la dernière
+    // synchronisation, en O(courbes changées) et non O(courbes)
+    curves.takeChanges(changedCurveSlots);
+    for (uint32_t slot : changedCurveSlots) {
+        CurveHandle handle = curves.handleOfSlot(slot);
+        const BezierCurve* curve = curves.get(handle);
+        refitCurveProxy(slot, handle, curve);
+        reindexCurvePoints(slot, handle, curve);
+    }
+}
+
+void BezierApp::refitCurveProxy(uint32_t slot, CurveHandle handle, const BezierCurve* curve) {
+    if (slot >= curveProxies.size()) {
+        curveProxies.resize(slot + 1);
+    }
+    CurveProxy& proxy = curveProxies[slot];
+
+    Point minPoint, maxPoint;
+    if (!curve || !curve->getBounds(minPoint, maxPoint)) {
+        // Courbe supprimée ou vide : pas de feuille
+        if (proxy.proxyId != DynamicAABBTree::NULL_NODE) {
+            curveTree.destroyProxy(proxy.proxyId);
+            proxy.proxyId = DynamicAABBTree::NULL_NODE;
+        }
+        return;
+    }
+
+    AABB bounds(minPoint, maxPoint);
+    if (proxy.proxyId == DynamicAABBTree::NULL_NODE) {
+        proxy.proxyId = curveTree.createProxy(bounds, static_cast<int>(slot));
+    } else {
+        curveTree.moveProxy(proxy.proxyId, bounds);
+    }
+    proxy.generation = handle.generation;
+}
+
+std::vector<CurveHandle> BezierApp::queryCurvesInBox(const Point& minPoint, const Point& maxPoint) {
+    // Sans effet si aucune courbe n'a changé depuis la synchronisation de l'image
+    syncCurveIndexes();
+
+    // Les boîtes de l'arbre sont élargies : vérifier la boîte exacte de chaque candidat
+    AABB area(minPoint, maxPoint);
+    std::vector<CurveHandle> result;
+    curveTree.queryBox(area, [&](int proxyId) {
+        uint32_t slot = static_cast<uint32_t>(curveTree.getUserData(proxyId));
+        CurveHandle handle{slot, curveProxies[slot].generation};
+        const BezierCurve* curve = curves.get(handle);
+        Point curveMin, curveMax;
+        if (curve && curve->getBounds(curveMin, curveMax) && area.overlaps(AABB(curveMin, curveMax))) {
+            result.push_back(handle);
+        }
+        return true;
+    });
+    return result;
+}
+
+std::vector<CurveHandle> BezierApp::findIntersectingCurves(CurveHandle handle) {
+    std::vector<CurveHandle> result;
+    const BezierCurve* curve = curves.get(handle);
+    Point minPoint, maxPoint;
+    if (!curve || !curve->getBounds(minPoint, maxPoint)) {
+        return result;
+    }
+
+    // Phase large par l'arbre, phase fine par les enveloppes convexes
+    for (CurveHandle other : queryCurvesInBox(minPoint, maxPoint)) {
+        if (other != handle && curve->intersectsWithCurve(*curves.get(other))) {
+            result.push_back(other);
+        }
+    }
+    return result;
+}
+
+void BezierApp::printCurveIntersections(CurveHandle handle) {
+    // Candidats par l'arbre de boîtes, puis points exacts par découpage de Bézier
+    const BezierCurve* curve = curves.get(handle);
+    Point minPoint, maxPoint;
+    if (!curve->getBounds(minPoint, maxPoint)) {
+        return;
+    }
+    std::vector<CurveHandle> candidates = queryCurvesInBox(minPoint, maxPoint);
+    size_t pointCount = 0;
+    for (CurveHandle other : candidates) {
+        if (other == handle) continue;
+        for (const CurveIntersection& hit : curve->computeIntersections(*curves.get(other))) {
+            std::cout << "  t1 = " << hit.t1 << ", t2 = " << hit.t2
+                      << " en (" << hit.point.x << ", " << hit.point.y << ")" << std::endl;
+            pointCount++;
+        }
+    }
+    std::cout << "Intersections de la courbe courante: " << pointCount << " point(s) avec "
+              << candidates.size() - 1 << " courbe(s) candidate(s)" << std::endl;
+}
+
+void BezierApp::detectAllIntersections() {
+    intersectingPairs = curveIntersector.findAllPairs(curves);
+    intersectionStatsValid = true;
+
+    const CurveIntersector::Stats& stats = curveIntersector.getStats();
+    std::cout << "Intersections: " << stats.intersectingPairs << " paire(s) sur " << stats.candidatePairs
+              << " candidate(s), " << stats.curveCount << " courbes, " << stats.totalMs() << " ms ("
+              << stats.threadCount << " thread(s))" << std::endl;
+}
+
+void BezierApp::drawCurves() {
+    if (!enableClipping || clipWindow.size() < 3) {
+        for (auto& curve : curves) {
+            curve.draw(*shader);
+        }
+        return;
+    }
+
+    // Les courbes hors de la boîte de la fenêtre de découpage ne produiraient aucun segment
+    // découpé : elles sont dessinées directement, sans passer par le découpage
+    std::fill(clipCandidates.begin(), clipCandidates.end(), 0);
+    clipCandidates.resize(curveProxies.size(), 0);
+    const AABB& window = clipWindow.getBounds();
+    for (CurveHandle handle : queryCurvesInBox(window.min, window.max)) {
+        clipCandidates[handle.index] = 1;
+    }
+
+    // Les polygones Sutherland-Hodgman à recalculer sont découpés ensemble, en parallèle, dans le
+    // repère de la scène : draw() trouve ensuite leur résultat dans le cache de chaque courbe
+    clipSubjects.clear();
+    clipSubjectCurves.clear();
+    for (size_t i = 0; i < curves.size(); i++) {
+        CurveHandle handle = curves.handleAt(i);
+        if (handle.index >= clipCandidates.size() || !clipCandidates[handle.index]) {
+            continue;
+        }
+        std::span<const Point> points = curves[i].polygonClipSubject(clipWindow);
+        if (!points.empty()) {
+            clipSubjects.push_back({points, curves[i].getWorldTransform()});
+            clipSubjectCurves.push_back(&curves[i]);
+        }
+    }
+    if (!clipSubjects.empty()) {
+        SutherlandHodgman::clipPolygons(clipSubjects, clipWindow, clippedPolygons, clipArenas);
+        // Affiché dans le panneau : ce lot peut être recalculé à chaque image pendant un glissement
+        clipBatchStats = ClipBatchStats();
+        clipBatchStats.curves = clipSubjects.size();
+        for (size_t i = 0; i < clipSubjectCurves.size(); i++) {
+            clipSubjectCurves[i]->setClippedPolygon(clipWindow, clippedPolygons[i]);
+            clipBatchStats.points += clippedPolygons[i].size();
+        }
+    }
+
+    for (size_t i = 0; i < curves.size(); i++) {
+        CurveHandle handle = curves.handleAt(i);
+        if (handle.index < clipCandidates.size() && clipCandidates[handle.index]) {
+            curves[i].draw(*shader, &clipWindow);
+        } else {
+            curves[i].draw(*shader);
+        }
+    }
+}
+
+void BezierApp::renderSelection() {
+    if (selectedCurves.empty() && !isBoxSelecting) {
+        return;
+    }
+
+    // Toutes les boîtes de la sélection sont envoyées en un seul buffer de segments
+    std::vector<Point> lines;
+    lines.reserve((selectedCurves.size() + 1) * 8);
+    auto addBox = [&lines](const Point& minPoint, const Point& maxPoint) {
+        Point corners[4] = {minPoint, Point(maxPoint.x, minPoint.y), maxPoint, Point(minPoint.x, maxPoint.y)};
+        for (int i = 0; i < 4; i++) {
+            lines.push_back(corners[i]);
+            lines.push_back(corners[(i + 1) % 4]);
+        }
+    };
+
+    float margin = 0.01f;
+    for (CurveHandle handle : selectedCurves) {
+        const BezierCurve* curve = curves.get(handle);
+        Point minPoint, maxPoint;
+        if (curve && curve->getBounds(minPoint, maxPoint)) {
+            addBox(Point(minPoint.x - margin, minPoint.y - margin), Point(maxPoint.x + margin, maxPoint.y + margin));
+        }
+    }
+    size_t selectionVertexCount = lines.size();
+
+    // Rectangle de sélection en cours
+    if (isBoxSelecting) {
+        addBox(Point(std::min(boxSelectStart.x, mouseX), std::min(boxSelectStart.y, mouseY)),
+               Point(std::max(boxSelectStart.x, mouseX), std::max(boxSelectStart.y, mouseY)));
+    }
+
+    static GLuint selectionVAO = 0, selectionVBO = 0;
+    if (selectionVAO == 0) {
+        glGenVertexArrays(1, &selectionVAO);
+        glGenBuffers(1, &selectionVBO);
+        glBindVertexArray(selectionVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, selectionVBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+    }
+
+    shader->Begin();
+    glBindVertexArray(selectionVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, selectionVBO);
+    glBufferData(GL_ARRAY_BUFFER, lines.size() * sizeof(Point), lines.data(), GL_STREAM_DRAW);
+
+    shader->SetUniform("color", 1.0f, 0.6f, 0.0f); // Orange
+    glDrawArrays(GL_LINES, 0, selectionVertexCount);
+
+    if (lines.size() > selectionVertexCount) {
+        shader->SetUniform("color", 0.6f, 0.6f, 1.0f);
+        glDrawArrays(GL_LINES, selectionVertexCount, lines.size() - selectionVertexCount);
+    }
+
+    glBindVertexArray(0);
+    shader->End();
+}
+
 void BezierApp::setupDefaultTexture() {
     // Créer une texture procédurale en damier
     const int size = 256;
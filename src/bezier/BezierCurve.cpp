@@ -1,14 +1,42 @@
 ﻿#include "../../include/bezier/BezierCurve.h"
+#include "../../include/bezier/CurveChain.h"
 #include "../../include/clipping/CyriusBeck.h"
 #include "../../include/clipping/SutherlandHodgman.h"
+#include "../../include/clipping/GreinerHormann.h"
+#include "../../include/commons/ConvexOverlap.h"
 #include <iostream>
 #include <chrono>
 #include <cmath>
 #include <algorithm>
 #include <limits>
 
-BezierCurve::BezierCurve() : step(0.01f), showDirectMethod(false), showDeCasteljau(false),
-                             clippingAlgorithm(ClippingAlgorithm::CYRUS_BECK) {
+namespace {
+    // Échange de contenu qui laisse à chaque tableau son arène : les deux courbes peuvent
+    // appartenir à des stores différents
+    void swapPoints(PointArray& a, PointArray& b) {
+        if (a.get_allocator() == b.get_allocator()) {
+            a.swap(b);
+            return;
+        }
+        PointArray temp(std::move(a));
+        a = std::move(b);
+        b = std::move(temp);
+    }
+
+    // Rend la mémoire du tableau à son arène
+    void releasePoints(PointArray& points) {
+        PointArray(points.get_allocator()).swap(points);
+    }
+}
+
+BezierCurve::BezierCurve(std::pmr::memory_resource* controlPointArena, std::pmr::memory_resource* sampleArena)
+        : controlPoints(controlPointArena), compactStorage(false), directMethodPoints(sampleArena),
+          deCasteljauPoints(sampleArena), clippingAlgorithm(ClippingAlgorithm::CYRUS_BECK),
+          directMethodSamples{PointArray(sampleArena)}, deCasteljauSamples{PointArray(sampleArena)},
+          stepLevel(7), showDirectMethod(false), showDeCasteljau(false), clippedBufferCapacity(0),
+          directMethodVertexCount(0), deCasteljauVertexCount(0), pendingUpdate(false), version(0),
+          changeLog(nullptr), changeSlot(0), hullValid(false), selfIntersectionsValid(false),
+          segmentTreeValid(false) {
     setupBuffers();
 }
 
@@ -32,6 +60,78 @@ BezierCurve::~BezierCurve() {
 
     glDeleteVertexArrays(1, &pointsVAO);
     glDeleteBuffers(1, &pointsVBO);
+
+    glDeleteVertexArrays(1, &clippedVAO);
+    glDeleteBuffers(1, &clippedVBO);
+}
+
+BezierCurve::BezierCurve(BezierCurve&& other) noexcept
+        : controlPoints(other.controlPoints.get_allocator()), compactStorage(false),
+          directMethodPoints(other.directMethodPoints.get_allocator()),
+          deCasteljauPoints(other.deCasteljauPoints.get_allocator()), clippingAlgorithm(ClippingAlgorithm::CYRUS_BECK),
+          directMethodSamples{PointArray(other.directMethodSamples.points.get_allocator())},
+          deCasteljauSamples{PointArray(other.deCasteljauSamples.points.get_allocator())}, stepLevel(7),
+          showDirectMethod(false), showDeCasteljau(false),
+          controlPolygonVAO(0), controlPolygonVBO(0), directMethodVAO(0), directMethodVBO(0),
+          deCasteljauVAO(0), deCasteljauVBO(0), pointsVAO(0), pointsVBO(0),
+          clippedVAO(0), clippedVBO(0), clippedBufferCapacity(0), directMethodVertexCount(0), deCasteljauVertexCount(0), pendingUpdate(false), version(0),
+          changeLog(nullptr), changeSlot(0), hullValid(false), selfIntersectionsValid(false), segmentTreeValid(false) {
+    // La courbe source garde des buffers nuls, ignorés par glDelete*
+    swap(other);
+}
+
+BezierCurve& BezierCurve::operator=(BezierCurve&& other) noexcept {
+    // Les anciens buffers de cette courbe seront libérés par la destruction de la source
+    if (this != &other) {
+        swap(other);
+    }
+    return *this;
+}
+
+void BezierCurve::swap(BezierCurve& other) noexcept {
+    using std::swap;
+    swapPoints(controlPoints, other.controlPoints);
+    swap(compactControlPoints, other.compactControlPoints);
+    swap(compactStorage, other.compactStorage);
+    swapPoints(directMethodPoints, other.directMethodPoints);
+    swapPoints(deCasteljauPoints, other.deCasteljauPoints);
+    swap(clippingAlgorithm, other.clippingAlgorithm);
+    swap(transform, other.transform);
+    swap(parentTransform, other.parentTransform);
+    swap(pascalTriangle, other.pascalTriangle);
+    swapPoints(directMethodSamples.points, other.directMethodSamples.points);
+    swap(directMethodSamples.level, other.directMethodSamples.level);
+    swapPoints(deCasteljauSamples.points, other.deCasteljauSamples.points);
+    swap(deCasteljauSamples.level, other.deCasteljauSamples.level);
+    swap(stepLevel, other.stepLevel);
+    swap(showDirectMethod, other.showDirectMethod);
+    swap(showDeCasteljau, other.showDeCasteljau);
+    swap(controlPolygonVAO, other.controlPolygonVAO);
+    swap(controlPolygonVBO, other.controlPolygonVBO);
+    swap(directMethodVAO, other.directMethodVAO);
+    swap(directMethodVBO, other.directMethodVBO);
+    swap(deCasteljauVAO, other.deCasteljauVAO);
+    swap(deCasteljauVBO, other.deCasteljauVBO);
+    swap(pointsVAO, other.pointsVAO);
+    swap(pointsVBO, other.pointsVBO);
+    swap(clippedVAO, other.clippedVAO);
+    swap(clippedVBO, other.clippedVBO);
+    swap(clippedBufferCapacity, other.clippedBufferCapacity);
+    swap(clipCache, other.clipCache);
+    swap(clippedPolylines, other.clippedPolylines);
+    swap(directMethodVertexCount, other.directMethodVertexCount);
+    swap(deCasteljauVertexCount, other.deCasteljauVertexCount);
+    swap(pendingUpdate, other.pendingUpdate);
+    swap(version, other.version);
+    swap(changeLog, other.changeLog);
+    swap(changeSlot, other.changeSlot);
+    swap(hull, other.hull);
+    swap(hullValid, other.hullValid);
+    swap(selfIntersections, other.selfIntersections);
+    swap(selfIntersectionsValid, other.selfIntersectionsValid);
+    swap(segmentPoints, other.segmentPoints);
+    swap(segmentTree, other.segmentTree);
+    swap(segmentTreeValid, other.segmentTreeValid);
 }
 
 void BezierCurve::setupBuffers() {
@@ -50,9 +150,131 @@ void BezierCurve::setupBuffers() {
     // Créer et configurer les VAOs et VBOs pour les points de contrôle
     glGenVertexArrays(1, &pointsVAO);
     glGenBuffers(1, &pointsVBO);
+
+    // Résultat du découpage : le VAO garde la liaison du VBO, même après un agrandissement
+    glGenVertexArrays(1, &clippedVAO);
+    glGenBuffers(1, &clippedVBO);
+    glBindVertexArray(clippedVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, clippedVBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void BezierCurve::uploadClipped(const std::vector<Point>& vertices) {
+    glBindBuffer(GL_ARRAY_BUFFER, clippedVBO);
+    if (vertices.size() > clippedBufferCapacity) {
+        // Agrandissement géométrique : les découpages suivants réécrivent le même stockage
+        clippedBufferCapacity = std::max(vertices.size(), clippedBufferCapacity + clippedBufferCapacity / 2);
+        glBufferData(GL_ARRAY_BUFFER, clippedBufferCapacity * sizeof(Point), nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Point), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool BezierCurve::isClipCacheValid(const ClipWindow& clipWindow) const {
+    return clipCache.windowVersion == clipWindow.getVersion() &&
+           clipCache.curveVersion == version && clipCache.algorithm == clippingAlgorithm;
+}
+
+std::span<const Point> BezierCurve::pointsForClipping() {
+    // En stockage compact, les points de la courbe ne sont gardés que sur le GPU :
+    // les recalculer une fois pour le découpage
+    if (compactStorage && directMethodPoints.empty() && deCasteljauPoints.empty()) {
+        recalculateCurves();
+    }
+
+    // Utiliser les points calculés par la méthode directe ou De Casteljau
+    return directMethodPoints.empty() ? std::span<const Point>(deCasteljauPoints) : directMethodPoints;
+}
+
+BezierCurve::ClipResult BezierCurve::storeClippedPolygon(const std::vector<Point>& clippedPolygon) {
+    if (clippedPolygon.empty()) {
+        return ClipResult::UNCLIPPED;
+    }
+    uploadClipped(clippedPolygon);
+    return ClipResult::POLYGON;
+}
+
+void BezierCurve::storeClipResult(const ClipWindow& clipWindow, ClipResult result, GLsizei polygonVertexCount) {
+    clipCache.curveVersion = version;
+    clipCache.windowVersion = clipWindow.getVersion();
+    clipCache.algorithm = clippingAlgorithm;
+    clipCache.result = result;
+    clipCache.polygonVertexCount = polygonVertexCount;
+}
+
+std::span<const Point> BezierCurve::polygonClipSubject(const ClipWindow& clipWindow) {
+    if (clippingAlgorithm != ClippingAlgorithm::SUTHERLAND_HODGMAN || !clipWindow.isConvex() ||
+        isClipCacheValid(clipWindow) || !isClosedCurve()) {
+        return {};
+    }
+    return pointsForClipping();
+}
+
+void BezierCurve::setClippedPolygon(const ClipWindow& clipWindow, const std::vector<Point>& clippedPolygon) {
+    ClipResult result = storeClippedPolygon(clippedPolygon);
+    storeClipResult(clipWindow, result, static_cast<GLsizei>(clippedPolygon.size()));
+}
+
+BezierCurve::ClipResult BezierCurve::updateClipCache(const ClipWindow& clipWindow) {
+    // Résultat encore valide : il est déjà dans clippedVBO
+    if (isClipCacheValid(clipWindow)) {
+        return clipCache.result;
+    }
+
+    std::span<const Point> curvePoints = pointsForClipping();
+
+    ClipResult result = ClipResult::UNCLIPPED;
+    GLsizei polygonVertexCount = 0;
+    if (!curvePoints.empty()) {
+        const bool closed = isClosedCurve();
+        if (clippingAlgorithm == ClippingAlgorithm::SUTHERLAND_HODGMAN && !closed) {
+            std::cout << "La courbe n'est pas fermée, impossible d'utiliser Sutherland-Hodgman comme un polygone" << std::endl;
+        } else if (clippingAlgorithm == ClippingAlgorithm::SUTHERLAND_HODGMAN && clipWindow.isConvex()) {
+            std::vector<Point> clippedPolygon = clipClosedCurveWithSH(clipWindow);
+            std::cout << "Sutherland-Hodgman a genere un polygone avec " << clippedPolygon.size() << " points." << std::endl;
+
+            result = storeClippedPolygon(clippedPolygon);
+            polygonVertexCount = static_cast<GLsizei>(clippedPolygon.size());
+        } else if (clippingAlgorithm == ClippingAlgorithm::CYRUS_BECK || !closed) {
+            // Tracés visibles de la courbe, découpée dans son repère local (le shader applique la
+            // transformation) : Cyrus-Beck si la fenêtre est convexe (une transformation affine ne
+            // change pas la convexité), découpage général sinon
+            clippedPolylines.clear();
+            if (clippingAlgorithm == ClippingAlgorithm::CYRUS_BECK && clipWindow.isConvex()) {
+                CyrusBeck::clipPolyline(curvePoints, localClipWindow(clipWindow), clippedPolylines);
+            } else {
+                GreinerHormann::clipPolyline(curvePoints, localClipWindow(clipWindow), clippedPolylines);
+            }
+            result = clippedPolylines.empty() ? ClipResult::EMPTY : ClipResult::POLYLINES;
+        } else {
+            // Courbe fermée et fenêtre quelconque : intersection des deux régions
+            GreinerHormann::Contours contours = GreinerHormann::clipPolygon(curvePoints, localClipWindow(clipWindow));
+            clippedPolylines.clear();
+            for (const auto& contour : contours) {
+                clippedPolylines.beginRun(contour[0]);
+                for (size_t i = 1; i < contour.size(); i++) {
+                    clippedPolylines.extendRun(contour[i]);
+                }
+            }
+            result = clippedPolylines.empty() ? ClipResult::EMPTY : ClipResult::CONTOURS;
+        }
+
+        if (result == ClipResult::POLYLINES || result == ClipResult::CONTOURS) {
+            uploadClipped(clippedPolylines.vertices);
+        }
+    }
+
+    storeClipResult(clipWindow, result, polygonVertexCount);
+    return result;
 }
 
 void BezierCurve::updateBuffers() {
+    // Nouvelle tessellation : le découpage en cache ne lui correspond plus
+    clipCache.windowVersion = 0;
+
     // Mettre à jour le VBO du polygone de contrôle
     if (!controlPoints.empty()) {
         glBindVertexArray(controlPolygonVAO);
@@ -82,6 +304,9 @@ void BezierCurve::updateBuffers() {
         glEnableVertexAttribArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
+        directMethodVertexCount = directMethodPoints.size();
+    } else if (!compactStorage) {
+        directMethodVertexCount = 0;
     }
 
     // Mettre à jour le VBO de la méthode de De Casteljau
@@ -93,7 +318,28 @@ void BezierCurve::updateBuffers() {
         glEnableVertexAttribArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
+        deCasteljauVertexCount = deCasteljauPoints.size();
+    } else if (!compactStorage) {
+        deCasteljauVertexCount = 0;
     }
+
+    pendingUpdate = false;
+}
+
+void BezierCurve::requestUpdate() {
+    pendingUpdate = true;
+}
+
+bool BezierCurve::hasPendingUpdate() const {
+    return pendingUpdate;
+}
+
+void BezierCurve::flushPendingUpdate() {
+    if (!pendingUpdate) {
+        return;
+    }
+    recalculateCurves();
+    updateBuffers();
 }
 
 void BezierCurve::generatePascalTriangle(int n) {
@@ -112,7 +358,9 @@ int BezierCurve::binomialCoeff(int n, int k) {
 }
 
 void BezierCurve::addControlPoint(float x, float y) {
-    controlPoints.push_back(Point(x, y));
+    bakeTransform();
+    controlPoints.push_back(toLocal(Point(x, y)));
+    updateHullWithPoint(controlPoints.back());
 
     // Régénérer le triangle de Pascal si nécessaire
     if (pascalTriangle.size() < controlPoints.size()) {
@@ -126,13 +374,38 @@ void BezierCurve::addControlPoint(float x, float y) {
         }
 
         // Recalculer les courbes si elles sont affichées
+        invalidateSamples();
         recalculateCurves();
+    } else {
+        // Premier point : pas d'échantillons, mais la boîte englobante apparaît
+        bumpVersion();
     }
 
     updateBuffers();
 }
 
+void BezierCurve::insertControlPoint(int index, float x, float y) {
+    bakeTransform();
+    if (index < 0 || index > static_cast<int>(controlPoints.size())) {
+        return;
+    }
+    controlPoints.insert(controlPoints.begin() + index, toLocal(Point(x, y)));
+    updateHullWithPoint(controlPoints[index]);
+
+    if (pascalTriangle.size() < controlPoints.size()) {
+        generatePascalTriangle(controlPoints.size() - 1);
+    }
+    if (controlPoints.size() >= 2 && !showDirectMethod && !showDeCasteljau) {
+        showDirectMethod = true;
+    }
+
+    invalidateSamples();
+    recalculateCurves();
+    updateBuffers();
+}
+
 void BezierCurve::closeCurve() {
+    bakeTransform();
     if (controlPoints.size() < 2) {
         std::cerr << "Impossible de fermer la courbe, il faut au moins 2 points." << std::endl;
         return;
@@ -141,58 +414,94 @@ void BezierCurve::closeCurve() {
     if (pascalTriangle.size() < controlPoints.size()) {
         generatePascalTriangle(controlPoints.size() - 1);
     }
+    invalidateSamples();
     recalculateCurves();
     updateBuffers();
 }
 
 
+void BezierCurve::setControlPoints(const std::vector<Point>& points) {
+    bakeTransform();
+    controlPoints.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        controlPoints[i] = toLocal(points[i]);
+    }
+    hullValid = false;
+
+    if (pascalTriangle.size() < controlPoints.size()) {
+        generatePascalTriangle(controlPoints.size() - 1);
+    }
+
+    // Recalcul différé : plusieurs modifications dans la même image ne coûtent qu'un recalcul
+    invalidateSamples();
+    requestUpdate();
+}
+
 void BezierCurve::updateControlPoint(int index, float x, float y) {
+    bakeTransform();
     if (index >= 0 && index < controlPoints.size()) {
-        controlPoints[index].x = x;
-        controlPoints[index].y = y;
+        // Un sommet de l'enveloppe déplacé impose un recalcul ; un point intérieur ne peut
+        // que l'agrandir
+        bool wasHullVertex = isHullVertex(controlPoints[index]);
+        controlPoints[index] = toLocal(Point(x, y));
+        if (wasHullVertex) {
+            hullValid = false;
+        } else {
+            updateHullWithPoint(controlPoints[index]);
+        }
 
         // Recalculer les courbes
+        invalidateSamples();
         recalculateCurves();
         updateBuffers();
     }
 }
 
 void BezierCurve::removeControlPoint(int index) {
+    bakeTransform();
     if (index >= 0 && index < controlPoints.size()) {
+        if (isHullVertex(controlPoints[index])) {
+            hullValid = false;
+        }
         controlPoints.erase(controlPoints.begin() + index);
 
         // Recalculer les courbes
+        invalidateSamples();
         recalculateCurves();
         updateBuffers();
     }
 }
 
 Point BezierCurve::getControlPoint(int index) const {
+    if (compactStorage) {
+        return getWorldTransform().apply(compactControlPoints.at(index));
+    }
     if (index >= 0 && index < controlPoints.size()) {
-        return controlPoints[index];
+        return getWorldTransform().apply(controlPoints[index]);
     }
     return Point(0, 0); // Point par défaut si l'index est invalide
 }
 
 float BezierCurve::distanceToControlPoint(int index, float x, float y) const {
-    if (index >= 0 && index < controlPoints.size()) {
+    if (index >= 0 && index < getControlPointCount()) {
         Point p(x, y);
-        return controlPoints[index].distanceTo(p);
+        return getControlPoint(index).distanceTo(p);
     }
     return std::numeric_limits<float>::max(); // Distance maximale si l'index est invalide
 }
 
 int BezierCurve::getNearestControlPoint(float x, float y) const {
-    if (controlPoints.empty()) {
+    const std::vector<Point> points = worldControlPoints();
+    if (points.empty()) {
         return -1;
     }
 
     Point p(x, y);
     int nearestIndex = 0;
-    float minDistance = controlPoints[0].distanceTo(p);
+    float minDistance = points[0].distanceTo(p);
 
-    for (int i = 1; i < controlPoints.size(); ++i) {
-        float distance = controlPoints[i].distanceTo(p);
+    for (int i = 1; i < points.size(); ++i) {
+        float distance = points[i].distanceTo(p);
         if (distance < minDistance) {
             minDistance = distance;
             nearestIndex = i;
@@ -208,7 +517,12 @@ int BezierCurve::getNearestControlPoint(float x, float y) const {
 }
 
 void BezierCurve::clearControlPoints() {
+    ensureEditable();
+    transform = Affine2D();
     controlPoints.clear();
+    hull.clear();
+    hullValid = true;
+    invalidateSamples();
     directMethodPoints.clear();
     deCasteljauPoints.clear();
     showDirectMethod = false;
@@ -217,14 +531,18 @@ void BezierCurve::clearControlPoints() {
 }
 
 void BezierCurve::increaseStep() {
-    step = std::min(0.1f, step + 0.001f);
-    std::cout << "Pas: " << step << std::endl;
+    stepLevel = std::max(MIN_STEP_LEVEL, stepLevel - 1);
+    bumpVersion();
+    segmentTreeValid = false;
+    std::cout << "Pas: " << getStep() << std::endl;
     recalculateCurves();
 }
 
 void BezierCurve::decreaseStep() {
-    step = std::max(0.001f, step - 0.001f);
-    std::cout << "Pas: " << step << std::endl;
+    stepLevel = std::min(MAX_STEP_LEVEL, stepLevel + 1);
+    bumpVersion();
+    segmentTreeValid = false;
+    std::cout << "Pas: " << getStep() << std::endl;
     recalculateCurves();
 }
 
@@ -237,29 +555,126 @@ void BezierCurve::recalculateCurves() {
     }
 }
 
+void BezierCurve::invalidateSamples() {
+    bumpVersion();
+    selfIntersectionsValid = false;
+    segmentTreeValid = false;
+    directMethodSamples.points.clear();
+    directMethodSamples.level = -1;
+    deCasteljauSamples.points.clear();
+    deCasteljauSamples.level = -1;
+}
+
+Point BezierCurve::evaluateDirect(float t) {
+    int n = getControlPointCount() - 1;
+    Point p(0, 0);
+    if (compactStorage) {
+        // Déquantification à la volée
+        CompactControlPoints::Reader reader = compactControlPoints.reader();
+        for (int i = 0; i <= n; i++) {
+            float bernstein = binomialCoeff(n, i) * pow(t, i) * pow(1 - t, n - i);
+            p = p + reader.next() * bernstein;
+        }
+        return p;
+    }
+    for (int i = 0; i <= n; i++) {
+        float bernstein = binomialCoeff(n, i) * pow(t, i) * pow(1 - t, n - i);
+        p = p + controlPoints[i] * bernstein;
+    }
+    return p;
+}
+
+Point BezierCurve::evaluateDeCasteljau(float t, std::vector<Point>& temp) const {
+    int n = getControlPointCount() - 1;
+
+    // Copier les points de contrôle (déquantifiés à la volée en stockage compact)
+    if (compactStorage) {
+        compactControlPoints.decode(temp);
+    } else {
+        temp.assign(controlPoints.begin(), controlPoints.end());
+    }
+
+    // Algorithme de De Casteljau
+    for (int j = 1; j <= n; j++) {
+        for (int i = 0; i <= n - j; i++) {
+            temp[i] = temp[i] * (1 - t) + temp[i + 1] * t;
+        }
+    }
+    return temp[0];
+}
+
+// Amène le cache au niveau demandé et renvoie le nombre de points réellement évalués.
+// Les échantillons déjà connus sont replacés aux indices multiples de 2^(level - ancien niveau),
+// seuls les nouveaux paramètres intermédiaires sont évalués.
+template <typename Evaluator>
+int BezierCurve::refineSamples(DyadicSamples& samples, int level, Evaluator evaluate) {
+    if (samples.level >= level) {
+        return 0;
+    }
+
+    const int count = (1 << level) + 1;
+    const float invCount = 1.0f / (1 << level);
+    PointArray refined(count, samples.points.get_allocator());
+    int evaluated = 0;
+
+    if (samples.level < 0) {
+        for (int i = 0; i < count; i++) {
+            refined[i] = evaluate(i * invCount);
+        }
+        evaluated = count;
+    } else {
+        const int stride = 1 << (level - samples.level);
+        for (int i = 0; i < count; i++) {
+            if (i % stride == 0) {
+                refined[i] = samples.points[i / stride];
+            } else {
+                refined[i] = evaluate(i * invCount);
+                evaluated++;
+            }
+        }
+    }
+
+    // Les extrémités sont exactement les points de contrôle extrêmes (repère local, comme les échantillons)
+    int last = getControlPointCount() - 1;
+    refined.front() = compactStorage ? compactControlPoints.at(0) : controlPoints.front();
+    refined.back() = compactStorage ? compactControlPoints.at(last) : controlPoints[last];
+
+    samples.points.swap(refined);
+    samples.level = level;
+    return evaluated;
+}
+
+void BezierCurve::extractLevel(const DyadicSamples& samples, int level, PointArray& out) {
+    const int stride = 1 << (samples.level - level);
+    const int count = (1 << level) + 1;
+    out.resize(count);
+    for (int i = 0; i < count; i++) {
+        out[i] = samples.points[i * stride];
+    }
+}
+
 void BezierCurve::calculateDirectMethod() {
     auto start = std::chrono::high_resolution_clock::now();
 
-    directMethodPoints.clear();
-    int n = controlPoints.size() - 1;
+    int n = getControlPointCount() - 1;
 
-    if (n < 1) return;
+    if (n < 1) {
+        directMethodPoints.clear();
+        return;
+    }
 
-    for (float t = 0; t <= 1.0f; t += step) {
-        Point p(0, 0);
-        for (int i = 0; i <= n; i++) {
-            float bernstein = binomialCoeff(n, i) * pow(t, i) * pow(1 - t, n - i);
-            p = p + controlPoints[i] * bernstein;
-        }
-        directMethodPoints.push_back(p);
+    if (pascalTriangle.size() < static_cast<size_t>(n) + 1) {
+        generatePascalTriangle(n);
     }
 
-    // Ajouter le dernier point (t = 1)
-    directMethodPoints.push_back(controlPoints[n]);
+    int evaluated = refineSamples(directMethodSamples, stepLevel,
+                                  [this](float t) { return evaluateDirect(t); });
+    extractLevel(directMethodSamples, stepLevel, directMethodPoints);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> duration = end - start;
-    std::cout << "Temps de calcul (méthode directe): " << duration.count() << " ms" << std::endl;
+    std::cout << "Temps de calcul (méthode directe): " << duration.count() << " ms ("
+              << evaluated << " points évalués)" << std::endl;
 
     showDirectMethod = true;
     updateBuffers();
@@ -268,38 +683,29 @@ void BezierCurve::calculateDirectMethod() {
 void BezierCurve::calculateDeCasteljau() {
     auto start = std::chrono::high_resolution_clock::now();
 
-    deCasteljauPoints.clear();
-    int n = controlPoints.size() - 1;
-
-    if (n < 1) return;
-
-    for (float t = 0; t <= 1.0f; t += step) {
-        // Copier les points de contrôle
-        std::vector<Point> temp = controlPoints;
-
-        // Algorithme de De Casteljau
-        for (int j = 1; j <= n; j++) {
-            for (int i = 0; i <= n - j; i++) {
-                temp[i] = temp[i] * (1 - t) + temp[i + 1] * t;
-            }
-        }
+    int n = getControlPointCount() - 1;
 
-        deCasteljauPoints.push_back(temp[0]);
+    if (n < 1) {
+        deCasteljauPoints.clear();
+        return;
     }
 
-    // Ajouter le dernier point (t = 1)
-    deCasteljauPoints.push_back(controlPoints[n]);
+    std::vector<Point> temp;
+    int evaluated = refineSamples(deCasteljauSamples, stepLevel,
+                                  [this, &temp](float t) { return evaluateDeCasteljau(t, temp); });
+    extractLevel(deCasteljauSamples, stepLevel, deCasteljauPoints);
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> duration = end - start;
-    std::cout << "Temps de calcul (De Casteljau): " << duration.count() << " ms" << std::endl;
+    std::cout << "Temps de calcul (De Casteljau): " << duration.count() << " ms ("
+              << evaluated << " points évalués)" << std::endl;
 
     showDeCasteljau = true;
     updateBuffers();
 }
 
 // Modifiez la méthode draw pour utiliser l'algorithme sélectionné
-void BezierCurve::draw(GLShader& shader, const std::vector<Point>* clipWindow) {
+void BezierCurve::draw(GLShader& shader, const ClipWindow* clipWindow) {
     static int drawCallCount = 0;
     drawCallCount++;
 
@@ -313,105 +719,75 @@ void BezierCurve::draw(GLShader& shader, const std::vector<Point>* clipWindow) {
     // }
 
     shader.Begin();
+    setModelMatrix(shader, getWorldTransform());
 
     // Dessiner le polygone de contrôle (lignes bleues)
-    if (controlPoints.size() >= 2) {
+    const int controlPointCount = getControlPointCount();
+    if (controlPointCount >= 2) {
         shader.SetUniform("color", 0.0f, 0.0f, 1.0f);
         glBindVertexArray(controlPolygonVAO);
-        glDrawArrays(GL_LINE_STRIP, 0, controlPoints.size());
+        glDrawArrays(GL_LINE_STRIP, 0, controlPointCount);
 
         // Dessiner les points de contrôle (points rouges)
         shader.SetUniform("color", 1.0f, 0.0f, 0.0f);
         glBindVertexArray(pointsVAO);
         glPointSize(5.0f);
-        glDrawArrays(GL_POINTS, 0, controlPoints.size());
+        glDrawArrays(GL_POINTS, 0, controlPointCount);
     }
 
     // Si une fenêtre de découpage est spécifiée et valide
     if (clipWindow && clipWindow->size() >= 3) {
-        // Utiliser les points calculés par la méthode directe ou De Casteljau
-        const std::vector<Point>& curvePoints = directMethodPoints.empty() ?
-                                              deCasteljauPoints : directMethodPoints;
-
-        if (!curvePoints.empty()) {
-            if (clippingAlgorithm == ClippingAlgorithm::CYRUS_BECK) {
-                // Vérifier si le polygone est convexe (nécessaire pour Cyrus-Beck)
-                if (CyrusBeck::isPolygonConvex(*clipWindow)) {
-                    // Découper la courbe avec l'algorithme de Cyrus-Beck
-                    std::vector<std::vector<Point>> clippedSegments =
-                        CyrusBeck::clipCurveToWindow(curvePoints, *clipWindow);
-
-                    // Dessiner chaque segment découpé
-                    for (const auto& segment : clippedSegments) {
-                        if (segment.size() >= 2) {
-                            // Créer un VAO et VBO temporaires pour chaque segment
-                            GLuint segmentVAO, segmentVBO;
-                            glGenVertexArrays(1, &segmentVAO);
-                            glGenBuffers(1, &segmentVBO);
-
-                            glBindVertexArray(segmentVAO);
-                            glBindBuffer(GL_ARRAY_BUFFER, segmentVBO);
-                            glBufferData(GL_ARRAY_BUFFER, segment.size() * sizeof(Point), segment.data(), GL_STATIC_DRAW);
-                            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)0);
-                            glEnableVertexAttribArray(0);
-
-                            // Dessiner le segment découpé
-                            shader.SetUniform("color", 0.0f, 1.0f, 1.0f); // Cyan
-                            glDrawArrays(GL_LINE_STRIP, 0, segment.size());
-
-                            // Nettoyer
-                            glDeleteVertexArrays(1, &segmentVAO);
-                            glDeleteBuffers(1, &segmentVBO);
-                        }
-                    }
-                } else {
-                    std::cout << "Le polygone n'est pas convexe, impossible d'utiliser Cyrus-Beck" << std::endl;
-                    // Passer à la méthode normale
-                    goto draw_normal;
-                }
-            } else if (clippingAlgorithm == ClippingAlgorithm::SUTHERLAND_HODGMAN) {
-                // Pour Sutherland-Hodgman, vérifier si la courbe est fermée
-                if (isClosedCurve()) {
-                    std::vector<Point> clippedPolygon = clipClosedCurveWithSH(*clipWindow);
-                    std::cout << "Sutherland-Hodgman a genere un polygone avec " << clippedPolygon.size() << " points." << std::endl;
-
-                    if (!clippedPolygon.empty()) {
-                        drawClippedWithSH(shader, clippedPolygon);
-                        // Sortir de la fonction après avoir dessiné le polygone découpé
-                        glBindVertexArray(0);
-                        shader.End();
-                        return;
-                    }
-                } else {
-                    std::cout << "La courbe n'est pas fermée, impossible d'utiliser Sutherland-Hodgman comme un polygone" << std::endl;
-                    // Passer à la méthode normale
-                    goto draw_normal;
-                }
-            }
+        switch (updateClipCache(*clipWindow)) {
+        case ClipResult::POLYLINES:
+            // Tracés continus rangés dans un seul buffer et dessinés en un appel
+            shader.SetUniform("color", 0.0f, 1.0f, 1.0f); // Cyan
+            glBindVertexArray(clippedVAO);
+            glMultiDrawArrays(GL_LINE_STRIP, clippedPolylines.first.data(), clippedPolylines.count.data(),
+                              static_cast<GLsizei>(clippedPolylines.runCount()));
+            break;
+        case ClipResult::POLYGON:
+            // Le polygone découpé est déjà dans le repère de la scène
+            setModelMatrix(shader, Affine2D());
+            drawClippedPolygon(shader, clipCache.polygonVertexCount);
+            // Sortir de la fonction après avoir dessiné le polygone découpé
+            glBindVertexArray(0);
+            shader.End();
+            return;
+        case ClipResult::CONTOURS:
+            drawClippedContours(shader);
+            // Sortir de la fonction après avoir dessiné la région découpée
+            setModelMatrix(shader, Affine2D());
+            glBindVertexArray(0);
+            shader.End();
+            return;
+        case ClipResult::EMPTY:
+        case ClipResult::UNCLIPPED:
+            break;
         }
     }
 
-draw_normal:  // AJOUT DE L'ÉTIQUETTE ICI
     // Si nous arrivons ici, soit il n'y a pas de découpage, soit le découpage a échoué
     // Nous dessinons donc la courbe normalement
     // Dessiner la courbe de Bézier (méthode directe)
-    if (showDirectMethod && directMethodPoints.size() >= 2) {
+    if (showDirectMethod && directMethodVertexCount >= 2) {
         shader.SetUniform("color", 0.0f, 1.0f, 0.0f);
         glBindVertexArray(directMethodVAO);
-        glDrawArrays(GL_LINE_STRIP, 0, directMethodPoints.size());
+        glDrawArrays(GL_LINE_STRIP, 0, directMethodVertexCount);
     }
 
     // Dessiner la courbe de Bézier (méthode de De Casteljau)
-    if (showDeCasteljau && deCasteljauPoints.size() >= 2) {
+    if (showDeCasteljau && deCasteljauVertexCount >= 2) {
         if (showDirectMethod) {
             shader.SetUniform("color", 1.0f, 0.0f, 1.0f);
         } else {
             shader.SetUniform("color", 0.0f, 1.0f, 0.0f);
         }
         glBindVertexArray(deCasteljauVAO);
-        glDrawArrays(GL_LINE_STRIP, 0, deCasteljauPoints.size());
+        glDrawArrays(GL_LINE_STRIP, 0, deCasteljauVertexCount);
     }
 
+    // Les autres dessins utilisant ce shader ne sont pas transformés
+    setModelMatrix(shader, Affine2D());
     glBindVertexArray(0);
     shader.End();
 }
@@ -442,11 +818,15 @@ void BezierCurve::showBoth() {
 }
 
 float BezierCurve::getStep() const {
-    return step;
+    return 1.0f / (1 << stepLevel);
+}
+
+int BezierCurve::getStepLevel() const {
+    return stepLevel;
 }
 
 int BezierCurve::getControlPointCount() const {
-    return controlPoints.size();
+    return compactStorage ? compactControlPoints.size() : controlPoints.size();
 }
 
 bool BezierCurve::isShowingDirectMethod() const {
@@ -458,95 +838,205 @@ bool BezierCurve::isShowingDeCasteljau() const {
 }
 
 // Méthodes de transformation
+// Les courbes de Bézier étant invariantes par transformation affine, les transformations
+// sont composées dans la matrice de la courbe et appliquées par le vertex shader :
+// aucun recalcul ni transfert des points n'est nécessaire.
 void BezierCurve::translate(float dx, float dy) {
-    for (auto& point : controlPoints) {
-        point.x += dx;
-        point.y += dy;
-    }
-
-    recalculateCurves();
-    updateBuffers();
+    applyWorldTransform(Affine2D::translation(dx, dy));
 }
 
 void BezierCurve::scale(float sx, float sy) {
-    // Calculer le centre du polygone de contrôle
-    float centerX = 0.0f, centerY = 0.0f;
-    for (const auto& point : controlPoints) {
-        centerX += point.x;
-        centerY += point.y;
+    // Appliquer le scaling par rapport au centre du polygone de contrôle
+    applyWorldTransform(Affine2D::about(Affine2D::scaling(sx, sy), computeCentroid()));
+}
+
+void BezierCurve::rotate(float angle) {
+    // Convertir l'angle en radians
+    float radians = angle * M_PI / 180.0f;
+
+    // Appliquer la rotation par rapport au centre
+    applyWorldTransform(Affine2D::about(Affine2D::rotation(radians), computeCentroid()));
+}
+
+void BezierCurve::shear(float shx, float shy) {
+    // Appliquer le cisaillement par rapport au centre
+    applyWorldTransform(Affine2D::about(Affine2D::shearing(shx, shy), computeCentroid()));
+}
+
+void BezierCurve::applyTransform(const Affine2D& m) {
+    transform = m * transform;
+    bumpVersion();
+}
+
+void BezierCurve::applyWorldTransform(const Affine2D& m) {
+    if (parentTransform.isIdentity()) {
+        applyTransform(m);
+        return;
     }
-    centerX /= controlPoints.size();
-    centerY /= controlPoints.size();
+    // Exprimer la transformation de la scène dans le repère du groupe parent
+    transform = parentTransform.inverse() * m * parentTransform * transform;
+    bumpVersion();
+}
 
-    // Appliquer le scaling par rapport au centre
-    for (auto& point : controlPoints) {
-        point.x = centerX + (point.x - centerX) * sx;
-        point.y = centerY + (point.y - centerY) * sy;
+uint64_t BezierCurve::getVersion() const {
+    return version;
+}
+
+void BezierCurve::setChangeLog(CurveChangeLog* log, uint32_t slot) {
+    changeLog = log;
+    changeSlot = slot;
+}
+
+void BezierCurve::bumpVersion() {
+    version++;
+    if (changeLog) {
+        changeLog->mark(changeSlot);
     }
+}
 
-    recalculateCurves();
-    updateBuffers();
+const Affine2D& BezierCurve::getTransform() const {
+    return transform;
 }
 
-void BezierCurve::rotate(float angle) {
-    // Convertir l'angle en radians
-    float radians = angle * M_PI / 180.0f;
-    float cosA = cos(radians);
-    float sinA = sin(radians);
+void BezierCurve::setParentTransform(const Affine2D& m) {
+    parentTransform = m;
+    bumpVersion();
+}
 
-    // Calculer le centre du polygone de contrôle
-    float centerX = 0.0f, centerY = 0.0f;
-    for (const auto& point : controlPoints) {
-        centerX += point.x;
-        centerY += point.y;
+const Affine2D& BezierCurve::getParentTransform() const {
+    return parentTransform;
+}
+
+Affine2D BezierCurve::getWorldTransform() const {
+    return parentTransform * transform;
+}
+
+void BezierCurve::localToWorld(std::vector<Point>& points) const {
+    Affine2D world = getWorldTransform();
+    if (world.isIdentity()) {
+        return;
+    }
+    for (auto& point : points) {
+        point = world.apply(point);
+    }
+}
+
+Point BezierCurve::toLocal(const Point& world) const {
+    // Appelée après bakeTransform : seule la transformation du groupe reste à inverser
+    return parentTransform.isIdentity() ? world : parentTransform.inverse().apply(world);
+}
+
+void BezierCurve::bakeTransform() {
+    if (transform.isIdentity()) {
+        return;
     }
-    centerX /= controlPoints.size();
-    centerY /= controlPoints.size();
 
-    // Appliquer la rotation par rapport au centre
-    for (auto& point : controlPoints) {
-        // Translater au centre
-        float x = point.x - centerX;
-        float y = point.y - centerY;
+    // En stockage compact, les échantillons ne sont plus en mémoire : il faudra les recalculer
+    bool wasCompact = compactStorage;
+    ensureEditable();
 
-        // Appliquer la rotation
-        float newX = x * cosA - y * sinA;
-        float newY = x * sinA + y * cosA;
+    for (auto& point : controlPoints) {
+        point = transform.apply(point);
+    }
 
-        // Translater de retour
-        point.x = newX + centerX;
-        point.y = newY + centerY;
+    // L'image affine des échantillons est l'échantillonnage de la courbe transformée
+    for (PointArray* points : {&directMethodSamples.points, &deCasteljauSamples.points,
+                               &directMethodPoints, &deCasteljauPoints}) {
+        for (auto& point : *points) {
+            point = transform.apply(point);
+        }
+    }
+    // L'image affine de l'enveloppe est l'enveloppe des points transformés (sens inversé
+    // par une symétrie)
+    for (auto& point : hull) {
+        point = transform.apply(point);
     }
+    if (transform.determinant() < 0.0f) {
+        std::reverse(hull.begin(), hull.end());
+    }
+    // Les paramètres des boucles ne changent pas, seuls leurs points sont transformés
+    for (auto& loop : selfIntersections) {
+        loop.point = transform.apply(loop.point);
+    }
+    segmentTreeValid = false;
+    transform = Affine2D();
 
-    recalculateCurves();
-    updateBuffers();
+    // Les échantillons libérés par le stockage compact seront recalculés avec le transfert
+    if (wasCompact) {
+        invalidateSamples();
+    }
+    // Le transfert vers le GPU est différé : une seule mise à jour par image, quel que soit
+    // le nombre de modifications (voir flushPendingUpdate)
+    requestUpdate();
 }
 
-void BezierCurve::shear(float shx, float shy) {
-    // Calculer le centre du polygone de contrôle
+Point BezierCurve::computeCentroid() const {
+    std::vector<Point> scratch;
+    std::span<const Point> points = controlPointsView(scratch);
+    if (points.empty()) {
+        return Point(0, 0);
+    }
+
+    // Calculer le centre du polygone de contrôle (l'image affine du centre est le centre de l'image)
     float centerX = 0.0f, centerY = 0.0f;
-    for (const auto& point : controlPoints) {
+    for (const auto& point : points) {
         centerX += point.x;
         centerY += point.y;
     }
-    centerX /= controlPoints.size();
-    centerY /= controlPoints.size();
+    centerX /= points.size();
+    centerY /= points.size();
 
-    // Appliquer le cisaillement par rapport au centre
-    for (auto& point : controlPoints) {
-        float dx = point.x - centerX;
-        float dy = point.y - centerY;
+    return getWorldTransform().apply(Point(centerX, centerY));
+}
 
-        point.x = centerX + dx + shx * dy;
-        point.y = centerY + dy + shy * dx;
+bool BezierCurve::getBounds(Point& minPoint, Point& maxPoint) const {
+    // La courbe est contenue dans l'enveloppe convexe de ses points de contrôle ; les extrema
+    // de l'image affine sont atteints sur les sommets de l'enveloppe (en cache)
+    const std::vector<Point>& points = localConvexHull();
+    if (points.empty()) {
+        return false;
     }
 
-    recalculateCurves();
-    updateBuffers();
+    Affine2D world = getWorldTransform();
+    minPoint = maxPoint = world.apply(points[0]);
+    for (const auto& local : points) {
+        Point point = world.apply(local);
+        minPoint.x = std::min(minPoint.x, point.x);
+        minPoint.y = std::min(minPoint.y, point.y);
+        maxPoint.x = std::max(maxPoint.x, point.x);
+        maxPoint.y = std::max(maxPoint.y, point.y);
+    }
+    return true;
+}
+
+std::vector<Point> BezierCurve::worldControlPoints() const {
+    std::vector<Point> scratch;
+    std::span<const Point> view = controlPointsView(scratch);
+    std::vector<Point> points(view.begin(), view.end());
+    localToWorld(points);
+    return points;
+}
+
+ClipWindow BezierCurve::localClipWindow(const ClipWindow& clipWindow) const {
+    Affine2D world = getWorldTransform();
+    if (world.isIdentity()) {
+        return clipWindow;
+    }
+
+    // Découper la courbe transformée par la fenêtre revient à découper la courbe
+    // par l'image inverse de la fenêtre
+    return clipWindow.transformed(world.inverse());
+}
+
+void BezierCurve::setModelMatrix(GLShader& shader, const Affine2D& m) {
+    float values[9];
+    m.toColumnMajor(values);
+    shader.SetUniformMatrix3("model", values);
 }
 
 // Méthode pour dupliquer un point de contrôle (multiplicité)
 void BezierCurve::duplicateControlPoint(int index) {
+    bakeTransform();
     if (index >= 0 && index < controlPoints.size()) {
         Point p = controlPoints[index];
         // Insérer le point dupliqué après le point original
@@ -557,168 +1047,291 @@ void BezierCurve::duplicateControlPoint(int index) {
             generatePascalTriangle(controlPoints.size() - 1);
         }
 
+        invalidateSamples();
         recalculateCurves();
         updateBuffers();
     }
 }
 
 // Méthodes pour l'enveloppe convexe
-int BezierCurve::orientation(const Point& p, const Point& q, const Point& r) const {
-    float val = (q.y - p.y) * (r.x - q.x) - (q.x - p.x) * (r.y - q.y);
-
-    if (fabs(val) < 1e-6) return 0;  // Colinéaire
-    return (val > 0) ? 1 : 2;  // Sens horaire ou anti-horaire
+std::vector<Point> BezierCurve::computeConvexHull() const {
+    std::vector<Point> result = localConvexHull();
+    Affine2D world = getWorldTransform();
+    if (world.isIdentity()) {
+        return result;
+    }
+    for (auto& point : result) {
+        point = world.apply(point);
+    }
+    if (world.determinant() < 0.0f) {
+        std::reverse(result.begin(), result.end());
+    }
+    return result;
 }
 
-std::vector<Point> BezierCurve::computeConvexHull() const {
-    std::vector<Point> hull;
+const std::vector<Point>& BezierCurve::localConvexHull() const {
+    if (!hullValid) {
+        std::vector<Point> scratch;
+        std::span<const Point> points = controlPointsView(scratch);
+        hull = monotoneChainHull(std::vector<Point>(points.begin(), points.end()));
+        hullValid = true;
+    }
+    return hull;
+}
 
-    // Besoin d'au moins 3 points pour former une enveloppe convexe
-    if (controlPoints.size() < 3) {
-        return controlPoints;  // Retourner tous les points
+std::vector<Point> BezierCurve::monotoneChainHull(std::vector<Point> points) {
+    std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end(), [](const Point& a, const Point& b) {
+        return a.x == b.x && a.y == b.y;
+    }), points.end());
+    if (points.size() < 3) {
+        return points;
     }
 
-    // Trouver le point le plus à gauche
-    int leftmost = 0;
-    for (int i = 1; i < controlPoints.size(); i++) {
-        if (controlPoints[i].x < controlPoints[leftmost].x) {
-            leftmost = i;
+    // Chaînes inférieure puis supérieure : un point qui ne tourne pas à gauche est retiré
+    std::vector<Point> result(2 * points.size());
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        while (k >= 2 && (result[k - 1] - result[k - 2]).cross(points[i] - result[k - 2]) <= 0.0f) {
+            k--;
         }
+        result[k++] = points[i];
     }
-
-    int p = leftmost;
-    int q;
-
-    // Algorithme de Jarvis (marche du cadeau)
-    do {
-        hull.push_back(controlPoints[p]);
-
-        q = (p + 1) % controlPoints.size();
-
-        for (int i = 0; i < controlPoints.size(); i++) {
-            if (orientation(controlPoints[p], controlPoints[i], controlPoints[q]) == 2) {
-                q = i;
-            }
+    for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && (result[k - 1] - result[k - 2]).cross(points[i] - result[k - 2]) <= 0.0f) {
+            k--;
         }
-
-        p = q;
-
-    } while (p != leftmost);
-
-    return hull;
+        result[k++] = points[i];
+    }
+    result.resize(k - 1); // le dernier point est le premier
+    return result;
 }
 
-bool BezierCurve::intersectsWithCurve(const BezierCurve& other) const {
-    // Calculer les enveloppes convexes des deux courbes
-    std::vector<Point> hull1 = computeConvexHull();
-    std::vector<Point> hull2 = other.computeConvexHull();
-
-    // Vérifier si les deux enveloppes convexes s'intersectent
-    // Implémentation simple : vérifier si l'un des segments de hull1 intersecte
-    // l'un des segments de hull2
-
-    for (int i = 0; i < hull1.size(); i++) {
-        int next_i = (i + 1) % hull1.size();
-
-        for (int j = 0; j < hull2.size(); j++) {
-            int next_j = (j + 1) % hull2.size();
-
-            // Vérifier si les segments (hull1[i], hull1[next_i]) et (hull2[j], hull2[next_j]) s'intersectent
-            int o1 = orientation(hull1[i], hull1[next_i], hull2[j]);
-            int o2 = orientation(hull1[i], hull1[next_i], hull2[next_j]);
-            int o3 = orientation(hull2[j], hull2[next_j], hull1[i]);
-            int o4 = orientation(hull2[j], hull2[next_j], hull1[next_i]);
-
-            // Si les orientations sont différentes, les segments s'intersectent
-            if (o1 != o2 && o3 != o4) {
-                return true;
-            }
+bool BezierCurve::isHullVertex(const Point& p) const {
+    if (!hullValid) {
+        return false;
+    }
+    for (const auto& vertex : hull) {
+        if (vertex.x == p.x && vertex.y == p.y) {
+            return true;
         }
     }
-
     return false;
 }
 
-// Méthodes pour le raccordement de courbes
-void BezierCurve::joinC0(BezierCurve& other) {
-    if (controlPoints.empty() || other.controlPoints.empty()) {
+void BezierCurve::updateHullWithPoint(const Point& p) {
+    // Enveloppe dégénérée : le prochain accès la recalcule
+    if (!hullValid || hull.size() < 3) {
+        hullValid = false;
         return;
     }
 
-    // Raccordement C0 : le dernier point de cette courbe est égal au premier point de l'autre courbe
-    Point lastPoint = controlPoints.back();
-    other.controlPoints[0] = lastPoint;
-
-    other.recalculateCurves();
-    other.updateBuffers();
-}
-
-void BezierCurve::joinC1(BezierCurve& other) {
-    if (controlPoints.size() < 2 || other.controlPoints.size() < 2) {
+    // Arêtes vues depuis p (p à droite de l'arête, enveloppe dans le sens trigonométrique)
+    const int count = static_cast<int>(hull.size());
+    std::vector<bool> visible(count);
+    bool outside = false;
+    for (int i = 0; i < count; i++) {
+        const Point& a = hull[i];
+        const Point& b = hull[(i + 1) % count];
+        visible[i] = (b - a).cross(p - a) < 0.0f;
+        outside = outside || visible[i];
+    }
+    // Point intérieur (ou sur le bord) : l'enveloppe ne change pas
+    if (!outside) {
         return;
     }
 
-    // Raccordement C0
-    joinC0(other);
+    // Les arêtes visibles forment une suite contiguë [first, last] : leurs sommets
+    // intérieurs sont remplacés par p
+    int first = 0;
+    while (!(visible[first] && !visible[(first + count - 1) % count])) {
+        first++;
+    }
+    int last = first;
+    while (visible[(last + 1) % count]) {
+        last = (last + 1) % count;
+    }
+
+    std::vector<Point> updated;
+    updated.reserve(count + 1);
+    for (int i = (last + 1) % count;; i = (i + 1) % count) {
+        updated.push_back(hull[i]);
+        if (i == first) {
+            break;
+        }
+    }
+    updated.push_back(p);
+    hull.swap(updated);
+}
 
-    // Raccordement C1 : les vecteurs tangents aux points de jonction sont colinéaires
-    // Nous alignons le deuxième point de la seconde courbe avec la tangente de la première
+std::vector<CurveIntersection> BezierCurve::computeIntersections(const BezierCurve& other, float tolerance) const {
+    // Les courbes peuvent appartenir à des groupes différents : comparer leurs points dans la scène
+    return BezierIntersection::intersect(worldControlPoints(), other.worldControlPoints(), tolerance);
+}
 
-    // Vecteur tangent à la fin de la première courbe
-    Point tangent1 = controlPoints[controlPoints.size() - 1] - controlPoints[controlPoints.size() - 2];
+std::vector<SelfIntersection> BezierCurve::getSelfIntersections() const {
+    if (!selfIntersectionsValid) {
+        // Les boucles sont invariantes par transformation affine : calcul dans le repère local
+        std::vector<Point> scratch;
+        std::span<const Point> points = controlPointsView(scratch);
+        selfIntersections = BezierIntersection::selfIntersect(std::vector<Point>(points.begin(), points.end()));
+        selfIntersectionsValid = true;
+    }
 
-    // Calculer la distance du deuxième point de la seconde courbe par rapport au point de jonction
-    Point p0 = other.controlPoints[0];
-    Point p1 = other.controlPoints[1];
-    float distance = p0.distanceTo(p1);
+    std::vector<SelfIntersection> result = selfIntersections;
+    Affine2D world = getWorldTransform();
+    for (auto& loop : result) {
+        loop.point = world.apply(loop.point);
+    }
+    return result;
+}
 
-    // Calculer le nouveau deuxième point pour maintenir la même distance mais suivre la tangente
-    Point newP1 = p0 + tangent1 * (distance / tangent1.distanceTo(Point(0, 0)));
+bool BezierCurve::hasSelfIntersections() const {
+    return !getSelfIntersections().empty();
+}
 
-    other.controlPoints[1] = newP1;
+void BezierCurve::buildSegmentTree() const {
+    // Tessellation au pas courant : celle déjà affichée si elle est disponible
+    const size_t count = (1u << stepLevel) + 1;
+    if (directMethodPoints.size() == count) {
+        segmentPoints.assign(directMethodPoints.begin(), directMethodPoints.end());
+    } else if (deCasteljauPoints.size() == count) {
+        segmentPoints.assign(deCasteljauPoints.begin(), deCasteljauPoints.end());
+    } else {
+        std::vector<Point> temp;
+        segmentPoints.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            segmentPoints[i] = evaluateDeCasteljau(static_cast<float>(i) / (count - 1), temp);
+        }
+    }
 
-    other.recalculateCurves();
-    other.updateBuffers();
+    segmentTree.clear();
+    for (size_t i = 0; i + 1 < segmentPoints.size(); i++) {
+        segmentTree.createProxy(AABB::fromPoints({segmentPoints[i], segmentPoints[i + 1]}), static_cast<int>(i));
+    }
+    segmentTreeValid = true;
 }
 
-void BezierCurve::joinC2(BezierCurve& other) {
-    if (controlPoints.size() < 3 || other.controlPoints.size() < 3) {
-        return;
+bool BezierCurve::pick(const Point& p, float radius, CurveHit& hit) const {
+    if (getControlPointCount() < 2) {
+        return false;
+    }
+    if (!segmentTreeValid) {
+        buildSegmentTree();
     }
 
-    // Raccordement C1
-    joinC1(other);
+    // La hiérarchie est dans le repère local : on y cherche l'image réciproque du carré de
+    // recherche, les distances sont ensuite mesurées dans la scène
+    Affine2D world = getWorldTransform();
+    Affine2D inverse = world.inverse();
+    AABB area = AABB::fromPoints({inverse.apply(Point(p.x - radius, p.y - radius)),
+                                  inverse.apply(Point(p.x + radius, p.y - radius)),
+                                  inverse.apply(Point(p.x + radius, p.y + radius)),
+                                  inverse.apply(Point(p.x - radius, p.y + radius))});
+
+    float bestSquared = radius * radius;
+    int bestSegment = -1;
+    float bestU = 0.0f;
+    segmentTree.queryBox(area, [&](int proxyId) {
+        int i = segmentTree.getUserData(proxyId);
+        Point a = world.apply(segmentPoints[i]);
+        Point b = world.apply(segmentPoints[i + 1]);
+        Point ab = b - a;
+        float lengthSquared = ab.x * ab.x + ab.y * ab.y;
+        float u = lengthSquared > 0.0f ? ((p.x - a.x) * ab.x + (p.y - a.y) * ab.y) / lengthSquared : 0.0f;
+        u = std::clamp(u, 0.0f, 1.0f);
+        float dx = a.x + ab.x * u - p.x;
+        float dy = a.y + ab.y * u - p.y;
+        float squared = dx * dx + dy * dy;
+        if (squared < bestSquared) {
+            bestSquared = squared;
+            bestSegment = i;
+            bestU = u;
+        }
+        return true;
+    });
+    if (bestSegment < 0) {
+        return false;
+    }
 
-    // Raccordement C2 : continuité de la courbure au point de jonction
-    // Nous devons ajuster le troisième point de la seconde courbe
+    // Affinage du paramètre sur la courbe exacte (section dorée autour du segment retenu)
+    const float step = 1.0f / (segmentPoints.size() - 1);
+    std::vector<Point> temp;
+    auto squaredDistance = [&](float t) {
+        Point q = world.apply(evaluateDeCasteljau(t, temp));
+        return (q.x - p.x) * (q.x - p.x) + (q.y - p.y) * (q.y - p.y);
+    };
+    const float ratio = 0.618034f;
+    float lo = std::max(0.0f, (bestSegment - 1) * step);
+    float hi = std::min(1.0f, (bestSegment + 2) * step);
+    float t1 = hi - ratio * (hi - lo), t2 = lo + ratio * (hi - lo);
+    float d1 = squaredDistance(t1), d2 = squaredDistance(t2);
+    for (int iteration = 0; iteration < 24; iteration++) {
+        if (d1 < d2) {
+            hi = t2;
+            t2 = t1;
+            d2 = d1;
+            t1 = hi - ratio * (hi - lo);
+            d1 = squaredDistance(t1);
+        } else {
+            lo = t1;
+            t1 = t2;
+            d1 = d2;
+            t2 = lo + ratio * (hi - lo);
+            d2 = squaredDistance(t2);
+        }
+    }
 
-    // Pour une courbe de Bézier cubique, la courbure dépend des trois premiers points
-    Point p0 = other.controlPoints[0];
-    Point p1 = other.controlPoints[1];
+    float t = 0.5f * (lo + hi);
+    float refined = squaredDistance(t);
+    // Distance non unimodale sur l'intervalle (boucle serrée) : garder la projection sur le segment
+    float segmentT = (bestSegment + bestU) * step;
+    float segmentDistance = squaredDistance(segmentT);
+    if (segmentDistance < refined) {
+        t = segmentT;
+        refined = segmentDistance;
+    }
 
-    // Pour une continuité C2, la formule est complexe mais peut être simplifiée
-    // dans le cas des courbes de Bézier. Nous utilisons une approximation :
+    hit.t = t;
+    hit.point = world.apply(evaluateDeCasteljau(t, temp));
+    hit.distance = std::sqrt(refined);
+    return true;
+}
 
-    // Dans la première courbe
-    Point q0 = controlPoints[controlPoints.size() - 3];
-    Point q1 = controlPoints[controlPoints.size() - 2];
-    Point q2 = controlPoints[controlPoints.size() - 1];
+bool BezierCurve::intersectsWithCurve(const BezierCurve& other) const {
+    // Calculer les enveloppes convexes des deux courbes
+    return hullsIntersect(computeConvexHull(), other.computeConvexHull());
+}
 
-    // Calculer le nouveau troisième point pour la continuité C2
-    // Formule simplifiée : p2 = 2*p1 - p0 + (q2 - 2*q1 + q0)
-    Point newP2 = p1 * 2.0f - p0 + (q2 - q1 * 2.0f + q0);
+bool BezierCurve::hullsIntersect(const std::vector<Point>& hull1, const std::vector<Point>& hull2) {
+    // Axes séparateurs en O(n + m), inclusion d'une enveloppe dans l'autre comprise
+    return ConvexOverlap::test(hull1, hull2).overlap;
+}
 
-    if (other.controlPoints.size() > 2) {
-        other.controlPoints[2] = newP2;
-    } else {
-        other.controlPoints.push_back(newP2);
-    }
+// Méthodes pour le raccordement de courbes
+// Le raccordement d'une paire est une chaîne de deux courbes : seule l'autre courbe est
+// modifiée (le début de la chaîne est fixe) et son recalcul est différé.
+void BezierCurve::joinC0(BezierCurve& other) {
+    CurveChain chain({this, &other});
+    chain.setFirstCurveFixed(true);
+    chain.enforce(CurveChain::Continuity::C0);
+}
 
-    other.recalculateCurves();
-    other.updateBuffers();
+void BezierCurve::joinC1(BezierCurve& other) {
+    CurveChain chain({this, &other});
+    chain.setFirstCurveFixed(true);
+    chain.enforce(CurveChain::Continuity::C1);
 }
 
-std::vector<Point> BezierCurve::clipClosedCurveWithSH(const std::vector<Point>& clipWindow) const {
+void BezierCurve::joinC2(BezierCurve& other) {
+    CurveChain chain({this, &other});
+    chain.setFirstCurveFixed(true);
+    chain.enforce(CurveChain::Continuity::C2);
+}
+
+std::vector<Point> BezierCurve::clipClosedCurveWithSH(const ClipWindow& clipWindow) const {
     // Vérifier si la courbe est fermée
     if (!isClosedCurve()) {
         std::cout << "La courbe n'est pas fermée, impossible d'appliquer Sutherland-Hodgman" << std::endl;
@@ -726,15 +1339,19 @@ std::vector<Point> BezierCurve::clipClosedCurveWithSH(const std::vector<Point>&
     }
 
     // Utiliser les points de la courbe calculée (directe ou De Casteljau)
-    const std::vector<Point>& curvePoints = directMethodPoints.empty() ?
-                                          deCasteljauPoints : directMethodPoints;
+    const PointArray& curvePoints = directMethodPoints.empty() ? deCasteljauPoints : directMethodPoints;
 
     if (curvePoints.empty()) {
         return std::vector<Point>();
     }
 
-    // Appliquer l'algorithme de Sutherland-Hodgman
-    return SutherlandHodgman::clipPolygon(curvePoints, clipWindow);
+    // Appliquer l'algorithme de Sutherland-Hodgman dans le repère de la courbe
+    std::vector<Point> clipped = SutherlandHodgman::clipPolygon(curvePoints, localClipWindow(clipWindow));
+    Affine2D world = getWorldTransform();
+    for (auto& point : clipped) {
+        point = world.apply(point);
+    }
+    return clipped;
 }
 
 void BezierCurve::drawClippedWithSH(GLShader& shader, const std::vector<Point>& clippedPolygon) {
@@ -744,43 +1361,137 @@ void BezierCurve::drawClippedWithSH(GLShader& shader, const std::vector<Point>&
 
     shader.Begin();
 
-    // Créer un VAO et VBO temporaires pour le polygone découpé
-    GLuint clippedVAO, clippedVBO;
-    glGenVertexArrays(1, &clippedVAO);
-    glGenBuffers(1, &clippedVBO);
+    // Le polygone découpé passe par le buffer persistant du découpage
+    uploadClipped(clippedPolygon);
+    // Le buffer ne correspond plus au résultat en cache
+    clipCache.windowVersion = 0;
+    drawClippedPolygon(shader, static_cast<GLsizei>(clippedPolygon.size()));
 
+    glBindVertexArray(0);
+    shader.End();
+}
+
+void BezierCurve::drawClippedPolygon(GLShader& shader, GLsizei vertexCount) {
     glBindVertexArray(clippedVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, clippedVBO);
-    glBufferData(GL_ARRAY_BUFFER, clippedPolygon.size() * sizeof(Point), clippedPolygon.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Point), (void*)0);
-    glEnableVertexAttribArray(0);
 
     // Dessiner le contour du polygone découpé
     shader.SetUniform("color", 0.0f, 0.8f, 0.8f);  // Cyan
-    glDrawArrays(GL_LINE_LOOP, 0, clippedPolygon.size());
+    glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
 
     // Dessiner un remplissage semi-transparent
     shader.SetUniform("color", 0.0f, 0.5f, 0.5f);  // Cyan foncé
     // Vous aurez besoin d'une fonction de triangulation pour remplir le polygone
     // Pour simplifier, on peut dessiner un éventail de triangles si le polygone est convexe
-    glDrawArrays(GL_TRIANGLE_FAN, 0, clippedPolygon.size());
+    glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCount);
+}
 
-    glDeleteVertexArrays(1, &clippedVAO);
-    glDeleteBuffers(1, &clippedVBO);
+void BezierCurve::drawClippedContours(GLShader& shader) {
+    const GLsizei runCount = static_cast<GLsizei>(clippedPolylines.runCount());
+    const GLint* first = clippedPolylines.first.data();
+    const GLsizei* count = clippedPolylines.count.data();
+    glBindVertexArray(clippedVAO);
 
-    shader.End();
+    // Remplissage pair-impair (régions concaves, trous) : chaque éventail inverse le stencil, puis
+    // seuls les pixels couverts un nombre impair de fois sont coloriés, en remettant le stencil à zéro
+    glEnable(GL_STENCIL_TEST);
+    glStencilMask(1);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glStencilFunc(GL_ALWAYS, 0, 1);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+    glMultiDrawArrays(GL_TRIANGLE_FAN, first, count, runCount);
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glStencilFunc(GL_EQUAL, 1, 1);
+    glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+    shader.SetUniform("color", 0.0f, 0.5f, 0.5f);  // Cyan foncé
+    glMultiDrawArrays(GL_TRIANGLE_FAN, first, count, runCount);
+    glDisable(GL_STENCIL_TEST);
+
+    // Dessiner les contours de la région découpée
+    shader.SetUniform("color", 0.0f, 0.8f, 0.8f);  // Cyan
+    glMultiDrawArrays(GL_LINE_LOOP, first, count, runCount);
 }
 
 bool BezierCurve::isClosedCurve() const {
     // Vérifier si le premier et le dernier point de contrôle sont identiques
-    if (controlPoints.size() < 3) {
+    if (getControlPointCount() < 3) {
         return false;
     }
 
-    const Point& first = controlPoints.front();
-    const Point& last = controlPoints.back();
+    const Point first = getControlPoint(0);
+    const Point last = getControlPoint(getControlPointCount() - 1);
 
     // Tolérance pour l'égalité flottante
     float distance = first.distanceTo(last);
     return distance < 0.001f;
+}
+
+// === Stockage compact ===
+void BezierCurve::setCompactStorage(bool enabled) {
+    if (enabled == compactStorage) {
+        return;
+    }
+    if (!enabled) {
+        ensureEditable();
+        return;
+    }
+
+    compactControlPoints.encode(controlPoints);
+    compactStorage = true;
+    bumpVersion(); // les points quantifiés diffèrent légèrement des points d'origine
+    hullValid = false;
+    segmentTreeValid = false;
+
+    // Les échantillons restent sur le GPU : libérer toutes les copies côté CPU
+    releasePoints(controlPoints);
+    releasePoints(directMethodPoints);
+    releasePoints(deCasteljauPoints);
+    releasePoints(directMethodSamples.points);
+    directMethodSamples.level = -1;
+    releasePoints(deCasteljauSamples.points);
+    deCasteljauSamples.level = -1;
+}
+
+bool BezierCurve::isCompactStorage() const {
+    return compactStorage;
+}
+
+float BezierCurve::getQuantizationError() const {
+    return compactStorage ? compactControlPoints.getMaxError() : 0.0f;
+}
+
+size_t BezierCurve::getMemoryUsage() const {
+    size_t bytes = sizeof(*this);
+    bytes += controlPoints.capacity() * sizeof(Point);
+    bytes += directMethodPoints.capacity() * sizeof(Point);
+    bytes += deCasteljauPoints.capacity() * sizeof(Point);
+    bytes += directMethodSamples.points.capacity() * sizeof(Point);
+    bytes += deCasteljauSamples.points.capacity() * sizeof(Point);
+    bytes += clippedPolylines.vertices.capacity() * sizeof(Point) +
+             (clippedPolylines.first.capacity() + clippedPolylines.count.capacity()) * sizeof(int);
+    for (const auto& row : pascalTriangle) {
+        bytes += row.capacity() * sizeof(int);
+    }
+    if (compactStorage) {
+        bytes += compactControlPoints.memoryUsage() - sizeof(compactControlPoints);
+    }
+    return bytes;
+}
+
+void BezierCurve::ensureEditable() {
+    if (!compactStorage) {
+        return;
+    }
+
+    compactControlPoints.decode(controlPoints);
+    compactControlPoints.clear();
+    compactStorage = false;
+}
+
+std::span<const Point> BezierCurve::controlPointsView(std::vector<Point>& scratch) const {
+    if (!compactStorage) {
+        return controlPoints;
+    }
+    compactControlPoints.decode(scratch);
+    return scratch;
 }
\ No newline at end of file
@@ -0,0 +1,275 @@
+﻿#include "../../include/bezier/BezierIntersection.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int MAX_DEPTH = 64;
+    // Un découpage qui garde plus de 80 % de l'intervalle ne converge pas assez : subdiviser
+    constexpr float MIN_REDUCTION = 0.8f;
+    constexpr float GEOMETRIC_EPSILON = 1e-7f;
+    constexpr int MAX_SIMPLE_SPLIT_DEPTH = 12;
+    // Intersections à la jonction de deux morceaux voisins (ou aux extrémités d'une courbe
+    // fermée) : points partagés par construction, pas des boucles
+    constexpr float JUNCTION_EPSILON = 1e-3f;
+    constexpr float PI = 3.14159265358979323846f;
+}
+
+std::vector<CurveIntersection> BezierIntersection::intersect(const std::vector<Point>& curve1,
+                                                            const std::vector<Point>& curve2,
+                                                            float tolerance) {
+    std::vector<CurveIntersection> result;
+    if (curve1.size() < 2 || curve2.size() < 2) {
+        return result;
+    }
+
+    clip(curve1, {0.0f, 1.0f}, curve2, {0.0f, 1.0f}, false, 0, tolerance, result);
+
+    // Une même intersection peut être trouvée depuis des sous-intervalles voisins ; aux points
+    // de tangence la précision n'est que de l'ordre de sqrt(tolerance) : regrouper ces résultats
+    const float mergeDistance = std::max(10.0f * tolerance, std::sqrt(tolerance));
+    std::sort(result.begin(), result.end(),
+              [](const CurveIntersection& a, const CurveIntersection& b) { return a.t1 < b.t1; });
+    std::vector<CurveIntersection> unique;
+    int clusterSize = 0;
+    for (const CurveIntersection& hit : result) {
+        if (!unique.empty() && std::fabs(hit.t1 - unique.back().t1) < mergeDistance &&
+            std::fabs(hit.t2 - unique.back().t2) < mergeDistance) {
+            // Moyenne courante des paramètres du groupe
+            clusterSize++;
+            unique.back().t1 += (hit.t1 - unique.back().t1) / clusterSize;
+            unique.back().t2 += (hit.t2 - unique.back().t2) / clusterSize;
+            continue;
+        }
+        unique.push_back(hit);
+        clusterSize = 1;
+    }
+
+    // Position évaluée sur la courbe d'origine
+    for (CurveIntersection& hit : unique) {
+        hit.point = evaluate(curve1, hit.t1);
+    }
+    return unique;
+}
+
+std::vector<SelfIntersection> BezierIntersection::selfIntersect(const std::vector<Point>& curve,
+                                                                float tolerance) {
+    std::vector<SelfIntersection> result;
+    if (curve.size() < 3) {
+        return result;
+    }
+
+    std::vector<Piece> pieces;
+    splitIntoSimplePieces(curve, {0.0f, 1.0f}, 0, pieces);
+    bool closed = curve.front().distanceTo(curve.back()) < GEOMETRIC_EPSILON;
+
+    for (size_t i = 0; i < pieces.size(); i++) {
+        for (size_t j = i + 1; j < pieces.size(); j++) {
+            const Piece& a = pieces[i];
+            const Piece& b = pieces[j];
+            if (!a.box.overlaps(b.box)) {
+                continue;
+            }
+
+            float lengthA = a.range.end - a.range.start;
+            float lengthB = b.range.end - b.range.start;
+            for (const CurveIntersection& hit : intersect(a.points, b.points, tolerance)) {
+                if (j == i + 1 && hit.t1 > 1.0f - JUNCTION_EPSILON && hit.t2 < JUNCTION_EPSILON) {
+                    continue;
+                }
+                float tStart = a.range.start + hit.t1 * lengthA;
+                float tEnd = b.range.start + hit.t2 * lengthB;
+                if (closed && tStart < JUNCTION_EPSILON && tEnd > 1.0f - JUNCTION_EPSILON) {
+                    continue;
+                }
+                result.push_back({tStart, tEnd, hit.point});
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const SelfIntersection& a, const SelfIntersection& b) { return a.tStart < b.tStart; });
+    return result;
+}
+
+void BezierIntersection::splitIntoSimplePieces(const std::vector<Point>& curve, Interval range, int depth,
+                                               std::vector<Piece>& out) {
+    // Directions des arêtes contenues dans un cône de moins de 180° : la dérivée garde une
+    // composante de signe constant, la courbe ne peut pas se recouper
+    if (depth >= MAX_SIMPLE_SPLIT_DEPTH || controlPolygonTurning(curve) < PI) {
+        out.push_back({curve, range, AABB::fromPoints(curve)});
+        return;
+    }
+
+    std::vector<Point> left, right;
+    split(curve, 0.5f, left, right);
+    float mid = (range.start + range.end) * 0.5f;
+    splitIntoSimplePieces(left, {range.start, mid}, depth + 1, out);
+    splitIntoSimplePieces(right, {mid, range.end}, depth + 1, out);
+}
+
+float BezierIntersection::controlPolygonTurning(const std::vector<Point>& curve) {
+    // Somme des angles (absolus) entre arêtes successives, arêtes nulles ignorées
+    float turning = 0.0f;
+    Point previous;
+    bool hasPrevious = false;
+    for (size_t i = 0; i + 1 < curve.size(); i++) {
+        Point edge = curve[i + 1] - curve[i];
+        if (std::fabs(edge.x) + std::fabs(edge.y) < GEOMETRIC_EPSILON) {
+            continue;
+        }
+        if (hasPrevious) {
+            float dot = previous.x * edge.x + previous.y * edge.y;
+            turning += std::fabs(std::atan2(previous.cross(edge), dot));
+        }
+        previous = edge;
+        hasPrevious = true;
+    }
+    return turning;
+}
+
+void BezierIntersection::clip(const std::vector<Point>& p, Interval pRange,
+                              const std::vector<Point>& q, Interval qRange,
+                              bool swapped, int depth, float tolerance, std::vector<CurveIntersection>& out) {
+    // Les courbes sont dans l'enveloppe convexe (donc la boîte) de leurs points de contrôle
+    AABB pBox = AABB::fromPoints(p), qBox = AABB::fromPoints(q);
+    if (!pBox.overlaps(qBox)) {
+        return;
+    }
+
+    bool pSmall = pRange.end - pRange.start < tolerance || pBox.perimeter() < GEOMETRIC_EPSILON;
+    bool qSmall = qRange.end - qRange.start < tolerance || qBox.perimeter() < GEOMETRIC_EPSILON;
+    if ((pSmall && qSmall) || depth >= MAX_DEPTH) {
+        float tp = (pRange.start + pRange.end) * 0.5f;
+        float tq = (qRange.start + qRange.end) * 0.5f;
+        out.push_back(swapped ? CurveIntersection{tq, tp, Point()} : CurveIntersection{tp, tq, Point()});
+        return;
+    }
+
+    float tMin = 0.0f, tMax = 1.0f;
+    if (!clipToFatLine(p, q, tMin, tMax)) {
+        return;
+    }
+
+    if (tMax - tMin > MIN_REDUCTION) {
+        // Peu de progrès (plusieurs intersections ou courbes tangentes) : subdiviser la plus longue
+        std::vector<Point> left, right;
+        if (pRange.end - pRange.start >= qRange.end - qRange.start) {
+            float mid = (pRange.start + pRange.end) * 0.5f;
+            split(p, 0.5f, left, right);
+            clip(q, qRange, left, {pRange.start, mid}, !swapped, depth + 1, tolerance, out);
+            clip(q, qRange, right, {mid, pRange.end}, !swapped, depth + 1, tolerance, out);
+        } else {
+            float mid = (qRange.start + qRange.end) * 0.5f;
+            split(q, 0.5f, left, right);
+            clip(p, pRange, left, {qRange.start, mid}, swapped, depth + 1, tolerance, out);
+            clip(p, pRange, right, {mid, qRange.end}, swapped, depth + 1, tolerance, out);
+        }
+        return;
+    }
+
+    // Réduire p à [tMin, tMax], puis découper q par la bande de la partie restante de p
+    float length = pRange.end - pRange.start;
+    Interval clipped = {pRange.start + tMin * length, pRange.start + tMax * length};
+    clip(q, qRange, subCurve(p, tMin, tMax), clipped, !swapped, depth + 1, tolerance, out);
+}
+
+bool BezierIntersection::clipToFatLine(const std::vector<Point>& p, const std::vector<Point>& q,
+                                       float& tMin, float& tMax) {
+    // Bande épaisse de q : droite passant par ses extrémités, épaissie des distances
+    // signées des points de contrôle intermédiaires
+    Point direction = q.back() - q.front();
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length < GEOMETRIC_EPSILON) {
+        // Courbe fermée (ou réduite à un point) : pas de droite de référence, pas de réduction
+        tMin = 0.0f;
+        tMax = 1.0f;
+        return true;
+    }
+    Point normal(-direction.y / length, direction.x / length);
+    auto distance = [&](const Point& point) {
+        return (point.x - q.front().x) * normal.x + (point.y - q.front().y) * normal.y;
+    };
+
+    float dMin = 0.0f, dMax = 0.0f;
+    for (const Point& point : q) {
+        float d = distance(point);
+        dMin = std::min(dMin, d);
+        dMax = std::max(dMax, d);
+    }
+    // Marge pour les erreurs d'arrondi
+    dMin -= GEOMETRIC_EPSILON;
+    dMax += GEOMETRIC_EPSILON;
+
+    // Fonction distance de p à la droite : courbe de Bézier explicite de points (i / n, d_i).
+    // L'intervalle cherché est celui où son enveloppe convexe coupe la bande [dMin, dMax] ;
+    // ses bornes sont atteintes sur un segment reliant deux points de contrôle.
+    const int n = static_cast<int>(p.size()) - 1;
+    std::vector<float> d(p.size());
+    for (int i = 0; i <= n; i++) {
+        d[i] = distance(p[i]);
+    }
+
+    float low = 2.0f, high = -1.0f;
+    auto include = [&](float t) {
+        low = std::min(low, t);
+        high = std::max(high, t);
+    };
+    for (int i = 0; i <= n; i++) {
+        float ti = static_cast<float>(i) / n;
+        if (d[i] >= dMin && d[i] <= dMax) {
+            include(ti);
+        }
+        for (int j = i + 1; j <= n; j++) {
+            float tj = static_cast<float>(j) / n;
+            for (float bound : {dMin, dMax}) {
+                if ((d[i] - bound) * (d[j] - bound) < 0.0f) {
+                    include(ti + (bound - d[i]) / (d[j] - d[i]) * (tj - ti));
+                }
+            }
+        }
+    }
+
+    if (low > high) {
+        return false;
+    }
+    tMin = std::max(0.0f, low);
+    tMax = std::min(1.0f, high);
+    return true;
+}
+
+void BezierIntersection::split(const std::vector<Point>& curve, float t,
+                               std::vector<Point>& left, std::vector<Point>& right) {
+    const size_t n = curve.size();
+    std::vector<Point> temp = curve;
+    left.resize(n);
+    right.resize(n);
+    for (size_t level = 0; level < n; level++) {
+        left[level] = temp[0];
+        right[n - 1 - level] = temp[n - 1 - level];
+        for (size_t i = 0; i + 1 < n - level; i++) {
+            temp[i] = temp[i] * (1.0f - t) + temp[i + 1] * t;
+        }
+    }
+}
+
+std::vector<Point> BezierIntersection::subCurve(const std::vector<Point>& curve, float t0, float t1) {
+    std::vector<Point> left, right;
+    // [t0, 1] puis [0, (t1 - t0) / (1 - t0)] de la partie droite
+    split(curve, t0, left, right);
+    if (t0 >= 1.0f) {
+        return right;
+    }
+    std::vector<Point> result;
+    split(right, (t1 - t0) / (1.0f - t0), result, left);
+    return result;
+}
+
+Point BezierIntersection::evaluate(const std::vector<Point>& curve, float t) {
+    std::vector<Point> temp = curve;
+    for (size_t level = 1; level < temp.size(); level++) {
+        for (size_t i = 0; i < temp.size() - level; i++) {
+            temp[i] = temp[i] * (1.0f - t) + temp[i + 1] * t;
+        }
+    }
+    return temp.empty() ? Point() : temp[0];
+}
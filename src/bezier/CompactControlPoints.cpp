@@ -0,0 +1,133 @@
+﻿#include "../../include/bezier/CompactControlPoints.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float QUANTIZATION_LEVELS = 65535.0f;
+}
+
+CompactControlPoints::CompactControlPoints()
+        : origin(0.0f, 0.0f), scaleX(0.0f), scaleY(0.0f), count(0), maxError(0.0f) {}
+
+void CompactControlPoints::clear() {
+    data.clear();
+    data.shrink_to_fit();
+    blockOffsets.clear();
+    blockOffsets.shrink_to_fit();
+    count = 0;
+    maxError = 0.0f;
+}
+
+void CompactControlPoints::encode(std::span<const Point> points) {
+    clear();
+    if (points.empty()) {
+        return;
+    }
+
+    // Boîte englobante de la courbe
+    float minX = points[0].x, maxX = points[0].x;
+    float minY = points[0].y, maxY = points[0].y;
+    for (const Point& p : points) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+
+    origin = Point(minX, minY);
+    scaleX = (maxX - minX) / QUANTIZATION_LEVELS;
+    scaleY = (maxY - minY) / QUANTIZATION_LEVELS;
+    count = points.size();
+
+    blockOffsets.reserve((count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    data.reserve(count * 2);
+
+    int32_t prevX = 0, prevY = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t qx = scaleX > 0.0f ? std::lround((points[i].x - minX) / scaleX) : 0;
+        int32_t qy = scaleY > 0.0f ? std::lround((points[i].y - minY) / scaleY) : 0;
+
+        if (i % BLOCK_SIZE == 0) {
+            // Point absolu en début de bloc
+            blockOffsets.push_back(data.size());
+            writeVarint(data, qx);
+            writeVarint(data, qy);
+        } else {
+            writeVarint(data, zigzag(qx - prevX));
+            writeVarint(data, zigzag(qy - prevY));
+        }
+
+        maxError = std::max(maxError, dequantize(qx, qy).distanceTo(points[i]));
+        prevX = qx;
+        prevY = qy;
+    }
+
+    data.shrink_to_fit();
+}
+
+Point CompactControlPoints::at(int index) const {
+    if (index < 0 || index >= count) {
+        return Point(0, 0);
+    }
+
+    size_t offset = blockOffsets[index / BLOCK_SIZE];
+    int32_t qx = readVarint(data, offset);
+    int32_t qy = readVarint(data, offset);
+    for (int i = 0; i < index % BLOCK_SIZE; i++) {
+        qx += unzigzag(readVarint(data, offset));
+        qy += unzigzag(readVarint(data, offset));
+    }
+    return dequantize(qx, qy);
+}
+
+size_t CompactControlPoints::memoryUsage() const {
+    return sizeof(*this) + data.capacity() + blockOffsets.capacity() * sizeof(uint32_t);
+}
+
+Point CompactControlPoints::dequantize(int32_t qx, int32_t qy) const {
+    return Point(origin.x + qx * scaleX, origin.y + qy * scaleY);
+}
+
+void CompactControlPoints::writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t CompactControlPoints::readVarint(const std::vector<uint8_t>& in, size_t& offset) {
+    uint32_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = in[offset++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+uint32_t CompactControlPoints::zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t CompactControlPoints::unzigzag(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+// === Lecture séquentielle ===
+CompactControlPoints::Reader::Reader(const CompactControlPoints& storage)
+        : storage(storage), offset(0), index(0), qx(0), qy(0) {}
+
+Point CompactControlPoints::Reader::next() {
+    if (index % BLOCK_SIZE == 0) {
+        qx = readVarint(storage.data, offset);
+        qy = readVarint(storage.data, offset);
+    } else {
+        qx += unzigzag(readVarint(storage.data, offset));
+        qy += unzigzag(readVarint(storage.data, offset));
+    }
+    index++;
+    return storage.dequantize(qx, qy);
+}
@@ -0,0 +1,191 @@
+﻿#include "../../include/bezier/CurveChain.h"
+#include <cmath>
+
+namespace {
+    constexpr float CHAIN_EPSILON = 1e-6f;
+}
+
+CurveChain::CurveChain(std::vector<BezierCurve*> curves) : curves(std::move(curves)) {}
+
+const char* CurveChain::getContinuityName(Continuity continuity) {
+    switch (continuity) {
+        case Continuity::C0: return "C0";
+        case Continuity::C1: return "C1";
+        case Continuity::G1: return "G1";
+        case Continuity::C2: return "C2";
+        default: return "Inconnue";
+    }
+}
+
+int CurveChain::enforce(Continuity continuity) {
+    // Ignorer les courbes sans segment
+    std::vector<BezierCurve*> valid;
+    for (BezierCurve* curve : curves) {
+        if (curve && curve->getControlPointCount() >= 2) {
+            valid.push_back(curve);
+        }
+    }
+    curves.swap(valid);
+    if (curves.size() < 2) {
+        return 0;
+    }
+
+    // Lecture unique des points dans le repère de la scène
+    points.assign(curves.size(), {});
+    changed.assign(curves.size(), false);
+    for (size_t i = 0; i < curves.size(); i++) {
+        int count = curves[i]->getControlPointCount();
+        points[i].reserve(count);
+        for (int j = 0; j < count; j++) {
+            points[i].push_back(curves[i]->getControlPoint(j));
+        }
+    }
+
+    enforceC0();
+    switch (continuity) {
+        case Continuity::C0:
+            break;
+        case Continuity::C1:
+            enforceTangents(true);
+            break;
+        case Continuity::G1:
+            enforceTangents(false);
+            break;
+        case Continuity::C2:
+            enforceC2();
+            break;
+    }
+
+    // Écriture des seules courbes modifiées, recalcul différé à la prochaine image
+    int modified = 0;
+    for (size_t i = 0; i < curves.size(); i++) {
+        if (changed[i]) {
+            curves[i]->setControlPoints(points[i]);
+            modified++;
+        }
+    }
+    return modified;
+}
+
+void CurveChain::setPoint(int curve, int index, const Point& p) {
+    Point& current = points[curve][index];
+    if (std::fabs(current.x - p.x) > CHAIN_EPSILON || std::fabs(current.y - p.y) > CHAIN_EPSILON) {
+        current = p;
+        changed[curve] = true;
+    }
+}
+
+void CurveChain::enforceC0() {
+    // Le début de chaque courbe rejoint la fin de la précédente
+    for (size_t i = 1; i < curves.size(); i++) {
+        setPoint(i, 0, points[i - 1].back());
+    }
+}
+
+void CurveChain::enforceTangents(bool matchMagnitude) {
+    for (size_t i = 1; i < curves.size(); i++) {
+        enforceTangentAt(i, matchMagnitude);
+    }
+}
+
+void CurveChain::enforceTangentAt(int joint, bool matchMagnitude) {
+    const std::vector<Point>& prev = points[joint - 1];
+    const std::vector<Point>& next = points[joint];
+    int degreePrev = prev.size() - 1;
+    int degreeNext = next.size() - 1;
+
+    // Les segments de droite n'ont pas de point intérieur à ajuster
+    if (degreeNext < 2) return;
+
+    Point tangent = prev[degreePrev] - prev[degreePrev - 1];
+    float length = tangent.distanceTo(Point(0, 0));
+    if (length < CHAIN_EPSILON) return;
+
+    Point newP1;
+    if (matchMagnitude) {
+        // C1 : n_a (A_n - A_n-1) = n_b (B_1 - B_0)
+        newP1 = next[0] + tangent * (static_cast<float>(degreePrev) / degreeNext);
+    } else {
+        // G1 : même direction, longueur de la poignée conservée
+        float handle = next[0].distanceTo(next[1]);
+        newP1 = next[0] + tangent * (handle / length);
+    }
+    setPoint(joint, 1, newP1);
+}
+
+void CurveChain::enforceC2() {
+    // Chaîne de cubiques : spline C2 globale par résolution tridiagonale
+    if (!firstCurveFixed && solveCubicSpline()) {
+        return;
+    }
+
+    // Sinon propagation de proche en proche, jonction par jonction (C1 puis C2) :
+    // n_b (n_b - 1) (B_2 - 2 B_1 + B_0) = n_a (n_a - 1) (A_n - 2 A_n-1 + A_n-2)
+    for (size_t i = 1; i < curves.size(); i++) {
+        enforceTangentAt(i, true);
+
+        const std::vector<Point>& prev = points[i - 1];
+        const std::vector<Point>& next = points[i];
+        int degreePrev = prev.size() - 1;
+        int degreeNext = next.size() - 1;
+        if (degreePrev < 2 || degreeNext < 3) continue;
+
+        Point secondPrev = prev[degreePrev] - prev[degreePrev - 1] * 2.0f + prev[degreePrev - 2];
+        float ratio = static_cast<float>(degreePrev * (degreePrev - 1)) / (degreeNext * (degreeNext - 1));
+        setPoint(i, 2, next[1] * 2.0f - next[0] + secondPrev * ratio);
+    }
+}
+
+bool CurveChain::solveCubicSpline() {
+    for (const auto& curvePoints : points) {
+        if (curvePoints.size() != 4) {
+            return false;
+        }
+    }
+
+    // Les jonctions K_0..K_n sont conservées ; les inconnues sont les premiers points
+    // intérieurs P1_i de chaque segment (spline naturelle, paramétrage uniforme) :
+    //   2 P1_0 + P1_1                   = K_0 + 2 K_1
+    //   P1_i-1 + 4 P1_i + P1_i+1        = 4 K_i + 2 K_i+1
+    //   2 P1_n-2 + 7 P1_n-1             = 8 K_n-1 + K_n
+    int n = curves.size();
+    std::vector<Point> knots(n + 1);
+    for (int i = 0; i < n; i++) {
+        knots[i] = points[i][0];
+    }
+    knots[n] = points[n - 1][3];
+
+    std::vector<float> a(n), b(n), c(n);
+    std::vector<Point> rhs(n);
+    for (int i = 0; i < n; i++) {
+        if (i == 0) {
+            a[i] = 0.0f; b[i] = 2.0f; c[i] = 1.0f;
+            rhs[i] = knots[0] + knots[1] * 2.0f;
+        } else if (i == n - 1) {
+            a[i] = 2.0f; b[i] = 7.0f; c[i] = 0.0f;
+            rhs[i] = knots[n - 1] * 8.0f + knots[n];
+        } else {
+            a[i] = 1.0f; b[i] = 4.0f; c[i] = 1.0f;
+            rhs[i] = knots[i] * 4.0f + knots[i + 1] * 2.0f;
+        }
+    }
+
+    // Algorithme de Thomas : élimination puis remontée, O(n)
+    for (int i = 1; i < n; i++) {
+        float m = a[i] / b[i - 1];
+        b[i] -= m * c[i - 1];
+        rhs[i] = rhs[i] - rhs[i - 1] * m;
+    }
+    std::vector<Point> p1(n);
+    p1[n - 1] = rhs[n - 1] * (1.0f / b[n - 1]);
+    for (int i = n - 2; i >= 0; i--) {
+        p1[i] = (rhs[i] - p1[i + 1] * c[i]) * (1.0f / b[i]);
+    }
+
+    for (int i = 0; i < n; i++) {
+        Point p2 = (i < n - 1) ? knots[i + 1] * 2.0f - p1[i + 1] : (knots[n] + p1[n - 1]) * 0.5f;
+        setPoint(i, 1, p1[i]);
+        setPoint(i, 2, p2);
+    }
+    return true;
+}
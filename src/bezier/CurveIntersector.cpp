@@ -0,0 +1,140 @@
+﻿#include "../../include/bezier/CurveIntersector.h"
+#include "../../include/commons/ConvexOverlap.h"
+#include "../../include/commons/ParallelFor.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    // En dessous de ce nombre d'éléments par thread, le coût de création des threads domine
+    constexpr size_t MIN_ITEMS_PER_THREAD = 256;
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int CurveIntersector::resolveThreadCount(size_t workItems) const {
+    return parallelThreadCount(threadCount, workItems, MIN_ITEMS_PER_THREAD);
+}
+
+std::vector<CurveIntersector::CurvePair> CurveIntersector::findAllPairs(const CurveStore& curves) {
+    stats = Stats();
+    stats.curveCount = curves.size();
+
+    // Enveloppes et boîtes de chaque courbe (indépendantes : calculées en parallèle)
+    auto start = std::chrono::steady_clock::now();
+    hulls.resize(curves.size());
+    std::vector<uint8_t> valid(curves.size(), 0);
+    std::vector<AABB> boxes(curves.size());
+    parallelFor(curves.size(), resolveThreadCount(curves.size()), [&](size_t begin, size_t end, int) {
+        for (size_t i = begin; i < end; i++) {
+            Point minPoint, maxPoint;
+            if (!curves[i].getBounds(minPoint, maxPoint)) {
+                continue;
+            }
+            hulls[i] = curves[i].computeConvexHull();
+            boxes[i] = AABB(minPoint, maxPoint);
+            valid[i] = 1;
+        }
+    });
+    entries.clear();
+    for (size_t i = 0; i < curves.size(); i++) {
+        if (valid[i]) {
+            entries.push_back({boxes[i], static_cast<uint32_t>(i)});
+        }
+    }
+    stats.prepareMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    sweepAndPrune();
+    stats.candidatePairs = candidates.size();
+    stats.broadPhaseMs = elapsedMs(start);
+
+    // Phase fine : chaque thread écrit le résultat de sa tranche de paires ; le cache des axes
+    // n'est que lu pendant le calcul parallèle
+    start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> keys(candidates.size());
+    std::vector<const Point*> cachedAxes(candidates.size(), nullptr);
+    for (size_t i = 0; i < candidates.size(); i++) {
+        keys[i] = pairKey(curves.handleAt(candidates[i].first), curves.handleAt(candidates[i].second));
+        auto it = separatingAxes.find(keys[i]);
+        if (it != separatingAxes.end()) {
+            cachedAxes[i] = &it->second;
+            stats.cachedAxes++;
+        }
+    }
+
+    std::vector<OverlapResult> results(candidates.size());
+    stats.threadCount = resolveThreadCount(candidates.size());
+    parallelFor(candidates.size(), stats.threadCount, [&](size_t begin, size_t end, int) {
+        for (size_t i = begin; i < end; i++) {
+            results[i] = ConvexOverlap::test(hulls[candidates[i].first], hulls[candidates[i].second], cachedAxes[i]);
+        }
+    });
+
+    // Seules les paires candidates de cet appel gardent leur axe
+    std::unordered_map<uint64_t, Point> axes;
+    std::vector<CurvePair> result;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (results[i].overlap) {
+            result.emplace_back(curves.handleAt(candidates[i].first), curves.handleAt(candidates[i].second));
+        } else {
+            axes.emplace(keys[i], results[i].axis);
+        }
+    }
+    separatingAxes.swap(axes);
+    stats.narrowPhaseMs = elapsedMs(start);
+    stats.intersectingPairs = result.size();
+
+    return result;
+}
+
+uint64_t CurveIntersector::pairKey(CurveHandle a, CurveHandle b) {
+    return (static_cast<uint64_t>(a.index) << 32) | b.index;
+}
+
+void CurveIntersector::sweepAndPrune() {
+    candidates.clear();
+    if (entries.empty()) {
+        return;
+    }
+
+    // Axe de balayage : celui où les centres des boîtes sont le plus dispersés
+    double mean[2] = {0.0, 0.0}, variance[2] = {0.0, 0.0};
+    for (const Entry& entry : entries) {
+        Point c = entry.box.center();
+        mean[0] += c.x;
+        mean[1] += c.y;
+        variance[0] += double(c.x) * c.x;
+        variance[1] += double(c.y) * c.y;
+    }
+    bool sweepX = variance[0] - mean[0] * mean[0] / entries.size() >=
+                  variance[1] - mean[1] * mean[1] / entries.size();
+
+    // Tri des boîtes sur l'axe de balayage : seules les boîtes qui commencent avant la fin
+    // de l'intervalle courant peuvent la chevaucher
+    std::sort(entries.begin(), entries.end(), [sweepX](const Entry& a, const Entry& b) {
+        return sweepX ? a.box.min.x < b.box.min.x : a.box.min.y < b.box.min.y;
+    });
+
+    // Intervalles rangés en tableaux séparés pour la boucle interne
+    size_t n = entries.size();
+    std::vector<float> sweepMin(n), sweepMax(n), otherMin(n), otherMax(n);
+    for (size_t i = 0; i < n; i++) {
+        const AABB& box = entries[i].box;
+        sweepMin[i] = sweepX ? box.min.x : box.min.y;
+        sweepMax[i] = sweepX ? box.max.x : box.max.y;
+        otherMin[i] = sweepX ? box.min.y : box.min.x;
+        otherMax[i] = sweepX ? box.max.y : box.max.x;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        const float end = sweepMax[i], low = otherMin[i], high = otherMax[i];
+        for (size_t j = i + 1; j < n && sweepMin[j] <= end; j++) {
+            if (otherMin[j] <= high && low <= otherMax[j]) {
+                uint32_t a = entries[i].curve, b = entries[j].curve;
+                candidates.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+    }
+}
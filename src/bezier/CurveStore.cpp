@@ -0,0 +1,121 @@
+﻿#include "../../include/bezier/CurveStore.h"
+#include <algorithm>
+
+namespace {
+    // Un niveau d'échantillonnage maximal (1025 points) tient encore dans un bloc de l'arène
+    constexpr size_t LARGEST_SAMPLE_BLOCK = 2048 * sizeof(Point);
+}
+
+CurveStore::CurveStore()
+        : sampleArena(std::pmr::pool_options{0, LARGEST_SAMPLE_BLOCK}) {
+}
+
+CurveHandle CurveStore::create() {
+    return create(curves.size());
+}
+
+CurveHandle CurveStore::create(size_t denseIndex) {
+    denseIndex = std::min(denseIndex, curves.size());
+
+    uint32_t slotIndex;
+    if (!freeSlots.empty()) {
+        // Réutiliser un emplacement libéré (sa génération a déjà été incrémentée)
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slotIndex = static_cast<uint32_t>(slots.size());
+        slots.push_back({0, 0});
+    }
+
+    curves.emplace(curves.begin() + denseIndex, &controlPointArena, &sampleArena);
+    denseToSlot.insert(denseToSlot.begin() + denseIndex, slotIndex);
+    for (uint32_t i = static_cast<uint32_t>(denseIndex); i < denseToSlot.size(); i++) {
+        slots[denseToSlot[i]].denseIndex = i;
+    }
+    curves[denseIndex].setChangeLog(&changes, slotIndex);
+    changes.mark(slotIndex);
+
+    return {slotIndex, slots[slotIndex].generation};
+}
+
+bool CurveStore::remove(CurveHandle handle) {
+    if (!isValid(handle)) {
+        return false;
+    }
+
+    uint32_t denseIndex = slots[handle.index].denseIndex;
+
+    // Décaler les courbes suivantes pour conserver l'ordre de création
+    // (l'extrusion et la sauvegarde dépendent de l'ordre des courbes)
+    curves.erase(curves.begin() + denseIndex);
+    denseToSlot.erase(denseToSlot.begin() + denseIndex);
+    for (uint32_t i = denseIndex; i < denseToSlot.size(); i++) {
+        slots[denseToSlot[i]].denseIndex = i;
+    }
+
+    // Invalider les poignées existantes et libérer l'emplacement
+    slots[handle.index].denseIndex = CurveHandle::INVALID_INDEX;
+    slots[handle.index].generation++;
+    freeSlots.push_back(handle.index);
+    changes.mark(handle.index);
+    return true;
+}
+
+void CurveStore::clear() {
+    for (uint32_t slot : denseToSlot) {
+        changes.mark(slot);
+    }
+    curves.clear();
+    denseToSlot.clear();
+    freeSlots.clear();
+    // Plus aucune courbe n'utilise les arènes : rendre leurs blocs
+    controlPointArena.release();
+    sampleArena.release();
+
+    // Conserver les générations pour que les anciennes poignées restent invalides
+    for (uint32_t i = 0; i < slots.size(); i++) {
+        slots[i].denseIndex = CurveHandle::INVALID_INDEX;
+        slots[i].generation++;
+        freeSlots.push_back(static_cast<uint32_t>(slots.size() - 1 - i));
+    }
+}
+
+void CurveStore::reserve(size_t count) {
+    curves.reserve(count);
+    denseToSlot.reserve(count);
+    slots.reserve(count);
+}
+
+bool CurveStore::isValid(CurveHandle handle) const {
+    return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+}
+
+BezierCurve* CurveStore::get(CurveHandle handle) {
+    return isValid(handle) ? &curves[slots[handle.index].denseIndex] : nullptr;
+}
+
+const BezierCurve* CurveStore::get(CurveHandle handle) const {
+    return isValid(handle) ? &curves[slots[handle.index].denseIndex] : nullptr;
+}
+
+CurveHandle CurveStore::handleAt(size_t denseIndex) const {
+    if (denseIndex >= curves.size()) {
+        return {};
+    }
+    uint32_t slotIndex = denseToSlot[denseIndex];
+    return {slotIndex, slots[slotIndex].generation};
+}
+
+CurveHandle CurveStore::handleOfSlot(uint32_t slot) const {
+    if (slot >= slots.size() || slots[slot].denseIndex == CurveHandle::INVALID_INDEX) {
+        return {};
+    }
+    return {slot, slots[slot].generation};
+}
+
+CurveHandle CurveStore::handleOf(const BezierCurve* curve) const {
+    if (curves.empty() || curve < curves.data() || curve >= curves.data() + curves.size()) {
+        return {};
+    }
+    return handleAt(static_cast<size_t>(curve - curves.data()));
+}
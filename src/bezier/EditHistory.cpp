@@ -0,0 +1,452 @@
+﻿#include "../../include/bezier/EditHistory.h"
+
+namespace {
+    std::vector<Point> worldControlPoints(const BezierCurve& curve) {
+        std::vector<Point> points(curve.getControlPointCount());
+        for (size_t i = 0; i < points.size(); i++) {
+            points[i] = curve.getControlPoint(static_cast<int>(i));
+        }
+        return points;
+    }
+}
+
+EditHistory::EditHistory(size_t memoryBudget)
+        : memoryBudget(memoryBudget), memoryUsage(0), dragging(false), groupDepth(0), groupHasEntry(false) {}
+
+size_t EditHistory::Edit::memoryUsage() const {
+    return sizeof(Edit) + curves.capacity() * sizeof(CurveId) + points.capacity() * sizeof(Point) +
+           indices.capacity() * sizeof(int);
+}
+
+// === Enregistrement ===
+
+void EditHistory::beginDrag() {
+    dragging = true;
+}
+
+void EditHistory::endDrag() {
+    dragging = false;
+    if (undoStack.empty() || !undoStack.back().open) {
+        return;
+    }
+
+    Edit& last = undoStack.back();
+    last.open = false;
+    // Un clic sans déplacement ne laisse pas d'entrée
+    if (last.type == Type::MOVE_POINT && last.from.x == last.to.x && last.from.y == last.to.y) {
+        memoryUsage -= last.memoryUsage();
+        undoStack.pop_back();
+    }
+}
+
+void EditHistory::beginGroup() {
+    if (groupDepth++ == 0) {
+        groupHasEntry = false;
+    }
+}
+
+void EditHistory::endGroup() {
+    if (groupDepth > 0) {
+        groupDepth--;
+    }
+}
+
+void EditHistory::recordPointMove(CurveHandle curve, int index, const Point& from, const Point& to) {
+    if (dragging && !undoStack.empty()) {
+        Edit& last = undoStack.back();
+        if (last.open && last.type == Type::MOVE_POINT && last.curve == curveId(curve) && last.index == index) {
+            last.to = to;
+            return;
+        }
+    }
+
+    Edit edit;
+    edit.type = Type::MOVE_POINT;
+    edit.curve = curveId(curve);
+    edit.index = index;
+    edit.from = from;
+    edit.to = to;
+    edit.open = dragging;
+    push(std::move(edit));
+}
+
+void EditHistory::recordPointInsert(CurveHandle curve, int index, const Point& point) {
+    Edit edit;
+    edit.type = Type::INSERT_POINT;
+    edit.curve = curveId(curve);
+    edit.index = index;
+    edit.to = point;
+    push(std::move(edit));
+}
+
+void EditHistory::recordPointRemove(CurveHandle curve, int index, const Point& point) {
+    Edit edit;
+    edit.type = Type::REMOVE_POINT;
+    edit.curve = curveId(curve);
+    edit.index = index;
+    edit.to = point;
+    push(std::move(edit));
+}
+
+void EditHistory::recordPointsTransform(CurveHandle curve, std::vector<int> indices, const Affine2D& m) {
+    if (indices.empty()) {
+        return;
+    }
+    Edit edit;
+    edit.type = Type::TRANSFORM_POINTS;
+    edit.curve = curveId(curve);
+    edit.indices = std::move(indices);
+    edit.matrix = m;
+    push(std::move(edit));
+}
+
+void EditHistory::recordPointsRemove(CurveHandle curve, std::vector<int> indices, std::vector<Point> points) {
+    if (indices.empty()) {
+        return;
+    }
+    Edit edit;
+    edit.type = Type::REMOVE_POINTS;
+    edit.curve = curveId(curve);
+    edit.indices = std::move(indices);
+    edit.points = std::move(points);
+    push(std::move(edit));
+}
+
+void EditHistory::recordTransform(const std::vector<CurveHandle>& curves, const Affine2D& m) {
+    if (curves.empty()) {
+        return;
+    }
+    Edit edit;
+    edit.type = Type::TRANSFORM;
+    edit.curves.reserve(curves.size());
+    for (CurveHandle handle : curves) {
+        edit.curves.push_back(curveId(handle));
+    }
+    edit.matrix = m;
+    push(std::move(edit));
+}
+
+void EditHistory::recordGroupTransform(SceneGraph::GroupId group, const Affine2D& m) {
+    Edit edit;
+    edit.type = Type::GROUP_TRANSFORM;
+    edit.group = group;
+    edit.matrix = m;
+    push(std::move(edit));
+}
+
+void EditHistory::recordCurveCreate(CurveHandle curve) {
+    Edit edit;
+    edit.type = Type::CREATE_CURVE;
+    edit.curve = curveId(curve);
+    edit.group = SceneGraph::ROOT;
+    push(std::move(edit));
+}
+
+void EditHistory::recordCurveDelete(CurveHandle curve, const CurveStore& curves, SceneGraph::GroupId group) {
+    const BezierCurve& data = *curves.get(curve);
+    Edit edit;
+    edit.type = Type::DELETE_CURVE;
+    edit.curve = curveId(curve);
+    edit.index = static_cast<int>(curves.denseIndexOf(curve));
+    edit.group = group;
+    edit.points = worldControlPoints(data);
+    edit.clippingAlgorithm = data.getClippingAlgorithm();
+    edit.showDirectMethod = data.isShowingDirectMethod();
+    edit.showDeCasteljau = data.isShowingDeCasteljau();
+    push(std::move(edit));
+}
+
+void EditHistory::push(Edit&& edit) {
+    // Une nouvelle action rend l'historique « rétablir » caduc
+    for (const Edit& e : redoStack) {
+        memoryUsage -= e.memoryUsage();
+    }
+    redoStack.clear();
+
+    if (groupDepth > 0) {
+        edit.chained = groupHasEntry;
+        groupHasEntry = true;
+    }
+    memoryUsage += edit.memoryUsage();
+    undoStack.push_back(std::move(edit));
+    enforceBudget();
+}
+
+void EditHistory::enforceBudget() {
+    // Les actions (groupes d'entrées) sont oubliées en entier ; la dernière est toujours gardée,
+    // même si elle dépasse seule le budget
+    while (memoryUsage > memoryBudget) {
+        size_t actionSize = 1;
+        while (actionSize < undoStack.size() && undoStack[actionSize].chained) {
+            actionSize++;
+        }
+        if (actionSize >= undoStack.size()) {
+            break;
+        }
+        for (size_t i = 0; i < actionSize; i++) {
+            memoryUsage -= undoStack.front().memoryUsage();
+            undoStack.pop_front();
+        }
+    }
+}
+
+void EditHistory::clear() {
+    undoStack.clear();
+    redoStack.clear();
+    memoryUsage = 0;
+    dragging = false;
+    groupDepth = 0;
+    groupHasEntry = false;
+    lastCurve = CurveHandle();
+    curveHandles.clear();
+    slotCurves.clear();
+}
+
+EditHistory::CurveId EditHistory::curveId(CurveHandle handle) {
+    // Une courbe reçoit son identifiant à sa première entrée dans le journal
+    if (handle.index == CurveHandle::INVALID_INDEX) {
+        return NO_CURVE;
+    }
+    if (handle.index >= slotCurves.size()) {
+        slotCurves.resize(handle.index + 1);
+    }
+    SlotCurve& slot = slotCurves[handle.index];
+    if (slot.id == NO_CURVE || slot.generation != handle.generation) {
+        CurveId id = static_cast<CurveId>(curveHandles.size());
+        curveHandles.push_back(handle);
+        slot = {handle.generation, id};
+    }
+    return slot.id;
+}
+
+void EditHistory::bindCurve(CurveId id, CurveHandle handle) {
+    curveHandles[id] = handle;
+    if (handle.index >= slotCurves.size()) {
+        slotCurves.resize(handle.index + 1);
+    }
+    slotCurves[handle.index] = {handle.generation, id};
+}
+
+void EditHistory::setMemoryBudget(size_t bytes) {
+    memoryBudget = bytes;
+    enforceBudget();
+}
+
+// === Annuler / rétablir ===
+
+bool EditHistory::undo(CurveStore& curves, SceneGraph& sceneGraph) {
+    endDrag();
+    bool applied = false;
+    while (!undoStack.empty()) {
+        Edit edit = std::move(undoStack.back());
+        undoStack.pop_back();
+        memoryUsage -= edit.memoryUsage();
+        bool chained = edit.chained;
+
+        // Une entrée dont les courbes ont disparu hors de l'historique est abandonnée
+        if (apply(edit, false, curves, sceneGraph)) {
+            memoryUsage += edit.memoryUsage();
+            redoStack.push_back(std::move(edit));
+            applied = true;
+        }
+        // Une action s'arrête à sa première entrée (non chaînée)
+        if (applied && !chained) {
+            return true;
+        }
+    }
+    return applied;
+}
+
+bool EditHistory::redo(CurveStore& curves, SceneGraph& sceneGraph) {
+    bool applied = false;
+    while (!redoStack.empty()) {
+        // Après la première entrée de l'action, seules les entrées chaînées suivent
+        if (applied && !redoStack.back().chained) {
+            break;
+        }
+        Edit edit = std::move(redoStack.back());
+        redoStack.pop_back();
+        memoryUsage -= edit.memoryUsage();
+
+        if (apply(edit, true, curves, sceneGraph)) {
+            memoryUsage += edit.memoryUsage();
+            undoStack.push_back(std::move(edit));
+            applied = true;
+        }
+    }
+    if (applied) {
+        enforceBudget();
+    }
+    return applied;
+}
+
+bool EditHistory::apply(Edit& edit, bool forward, CurveStore& curves, SceneGraph& sceneGraph) {
+    CurveHandle handle = handleOf(edit.curve);
+    switch (edit.type) {
+        case Type::MOVE_POINT: {
+            BezierCurve* curve = curves.get(handle);
+            if (!curve || edit.index >= curve->getControlPointCount()) {
+                return false;
+            }
+            const Point& p = forward ? edit.to : edit.from;
+            curve->updateControlPoint(edit.index, p.x, p.y);
+            lastCurve = handle;
+            return true;
+        }
+
+        case Type::INSERT_POINT:
+        case Type::REMOVE_POINT: {
+            BezierCurve* curve = curves.get(handle);
+            if (!curve) {
+                return false;
+            }
+            if (forward == (edit.type == Type::INSERT_POINT)) {
+                if (edit.index > curve->getControlPointCount()) {
+                    return false;
+                }
+                curve->insertControlPoint(edit.index, edit.to.x, edit.to.y);
+            } else {
+                if (edit.index >= curve->getControlPointCount()) {
+                    return false;
+                }
+                curve->removeControlPoint(edit.index);
+            }
+            lastCurve = handle;
+            return true;
+        }
+
+        case Type::TRANSFORM_POINTS: {
+            BezierCurve* curve = curves.get(handle);
+            if (!curve || edit.indices.back() >= curve->getControlPointCount()) {
+                return false;
+            }
+            Affine2D m = forward ? edit.matrix : edit.matrix.inverse();
+            std::vector<Point> points = worldControlPoints(*curve);
+            for (int i : edit.indices) {
+                points[i] = m.apply(points[i]);
+            }
+            curve->setControlPoints(points);
+            lastCurve = handle;
+            return true;
+        }
+
+        case Type::REMOVE_POINTS: {
+            BezierCurve* curve = curves.get(handle);
+            if (!curve) {
+                return false;
+            }
+            std::vector<Point> current = worldControlPoints(*curve);
+            std::vector<Point> result;
+            if (forward) {
+                if (edit.indices.back() >= static_cast<int>(current.size())) {
+                    return false;
+                }
+                result.reserve(current.size() - edit.indices.size());
+                size_t k = 0;
+                for (int i = 0; i < static_cast<int>(current.size()); i++) {
+                    if (k < edit.indices.size() && edit.indices[k] == i) {
+                        k++;
+                    } else {
+                        result.push_back(current[i]);
+                    }
+                }
+            } else {
+                // Fusion : les indices désignent les positions dans la courbe d'avant le retrait
+                size_t total = current.size() + edit.indices.size();
+                if (edit.indices.back() >= static_cast<int>(total)) {
+                    return false;
+                }
+                result.reserve(total);
+                size_t k = 0, j = 0;
+                for (size_t i = 0; i < total; i++) {
+                    if (k < edit.indices.size() && edit.indices[k] == static_cast<int>(i)) {
+                        result.push_back(edit.points[k++]);
+                    } else {
+                        result.push_back(current[j++]);
+                    }
+                }
+            }
+            curve->setControlPoints(result);
+            lastCurve = handle;
+            return true;
+        }
+
+        case Type::TRANSFORM: {
+            Affine2D m = forward ? edit.matrix : edit.matrix.inverse();
+            bool applied = false;
+            for (CurveId id : edit.curves) {
+                if (BezierCurve* curve = curves.get(handleOf(id))) {
+                    curve->applyTransform(m);
+                    lastCurve = handleOf(id);
+                    applied = true;
+                }
+            }
+            return applied;
+        }
+
+        case Type::GROUP_TRANSFORM: {
+            if (!sceneGraph.isValid(edit.group)) {
+                return false;
+            }
+            sceneGraph.applyTransform(edit.group, forward ? edit.matrix : edit.matrix.inverse());
+            lastCurve = CurveHandle();
+            return true;
+        }
+
+        case Type::CREATE_CURVE:
+        case Type::DELETE_CURVE: {
+            if (forward == (edit.type == Type::CREATE_CURVE)) {
+                restoreCurve(edit, curves, sceneGraph);
+                return true;
+            }
+            if (!curves.isValid(handle)) {
+                return false;
+            }
+            removeCurve(edit, curves, sceneGraph);
+            return true;
+        }
+    }
+    return false;
+}
+
+void EditHistory::removeCurve(Edit& edit, CurveStore& curves, SceneGraph& sceneGraph) {
+    // L'état est relu au moment de la suppression : la courbe a pu changer depuis l'enregistrement
+    CurveHandle handle = handleOf(edit.curve);
+    const BezierCurve* curve = curves.get(handle);
+    edit.points = worldControlPoints(*curve);
+    edit.clippingAlgorithm = curve->getClippingAlgorithm();
+    edit.showDirectMethod = curve->isShowingDirectMethod();
+    edit.showDeCasteljau = curve->isShowingDeCasteljau();
+    edit.group = sceneGraph.groupOf(handle);
+    edit.index = static_cast<int>(curves.denseIndexOf(handle));
+
+    sceneGraph.removeCurve(handle);
+    curves.remove(handle);
+    lastCurve = CurveHandle();
+}
+
+void EditHistory::restoreCurve(Edit& edit, CurveStore& curves, SceneGraph& sceneGraph) {
+    CurveHandle handle = edit.index >= 0 ? curves.create(edit.index) : curves.create();
+    BezierCurve* curve = curves.get(handle);
+    curve->setClippingAlgorithm(edit.clippingAlgorithm);
+    curve->setControlPoints(edit.points);
+    if (edit.showDirectMethod) {
+        curve->toggleDirectMethod();
+    }
+    if (edit.showDeCasteljau) {
+        curve->toggleDeCasteljau();
+    }
+
+    SceneGraph::GroupId group = sceneGraph.isValid(edit.group) ? edit.group : SceneGraph::ROOT;
+    if (group != SceneGraph::ROOT) {
+        sceneGraph.addCurve(group, handle, curves);
+    }
+
+    // Les points ne servent plus tant que la courbe existe
+    edit.points.clear();
+    edit.points.shrink_to_fit();
+
+    // Les entrées gardent l'identifiant : seule sa poignée change
+    bindCurve(edit.curve, handle);
+    lastCurve = handle;
+}
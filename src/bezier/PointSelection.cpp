@@ -0,0 +1,156 @@
+﻿#include "../../include/bezier/PointSelection.h"
+#include <bit>
+
+void PointSelection::clear() {
+    curves.clear();
+    total = 0;
+}
+
+PointSelection::CurveBits* PointSelection::find(CurveHandle curve) {
+    if (curve.index >= curves.size() || curves[curve.index].generation != curve.generation) {
+        return nullptr;
+    }
+    return &curves[curve.index];
+}
+
+const PointSelection::CurveBits* PointSelection::find(CurveHandle curve) const {
+    if (curve.index >= curves.size() || curves[curve.index].generation != curve.generation) {
+        return nullptr;
+    }
+    return &curves[curve.index];
+}
+
+PointSelection::CurveBits& PointSelection::acquire(CurveHandle curve) {
+    if (curve.index >= curves.size()) {
+        curves.resize(curve.index + 1);
+    }
+    CurveBits& bits = curves[curve.index];
+    if (bits.generation != curve.generation) {
+        // Emplacement réutilisé : l'ancienne sélection n'a plus de sens
+        total -= bits.count;
+        bits = CurveBits();
+        bits.generation = curve.generation;
+    }
+    return bits;
+}
+
+void PointSelection::select(CurveHandle curve, int index, bool selected) {
+    if (index < 0) {
+        return;
+    }
+    CurveBits& bits = acquire(curve);
+    size_t word = static_cast<size_t>(index) >> 6;
+    if (word >= bits.words.size()) {
+        if (!selected) {
+            return;
+        }
+        bits.words.resize(word + 1, 0);
+    }
+    uint64_t mask = 1ull << (index & 63);
+    bool wasSelected = (bits.words[word] & mask) != 0;
+    if (wasSelected == selected) {
+        return;
+    }
+    bits.words[word] ^= mask;
+    if (selected) {
+        bits.count++;
+        total++;
+    } else {
+        bits.count--;
+        total--;
+    }
+}
+
+void PointSelection::selectAll(CurveHandle curve, int count) {
+    if (count <= 0) {
+        return;
+    }
+    CurveBits& bits = acquire(curve);
+    size_t wordCount = (static_cast<size_t>(count) + 63) >> 6;
+    bits.words.assign(wordCount, ~0ull);
+    if (count & 63) {
+        bits.words.back() = (1ull << (count & 63)) - 1;
+    }
+    total += count - bits.count;
+    bits.count = count;
+}
+
+bool PointSelection::isSelected(CurveHandle curve, int index) const {
+    const CurveBits* bits = find(curve);
+    if (!bits || index < 0) {
+        return false;
+    }
+    size_t word = static_cast<size_t>(index) >> 6;
+    return word < bits->words.size() && (bits->words[word] >> (index & 63)) & 1;
+}
+
+size_t PointSelection::count(CurveHandle curve) const {
+    const CurveBits* bits = find(curve);
+    return bits ? bits->count : 0;
+}
+
+std::vector<CurveHandle> PointSelection::getCurves() const {
+    std::vector<CurveHandle> result;
+    for (uint32_t slot = 0; slot < curves.size(); slot++) {
+        if (curves[slot].count > 0) {
+            result.push_back(CurveHandle{slot, curves[slot].generation});
+        }
+    }
+    return result;
+}
+
+std::vector<int> PointSelection::getIndices(CurveHandle curve) const {
+    std::vector<int> result;
+    const CurveBits* bits = find(curve);
+    if (!bits) {
+        return result;
+    }
+    result.reserve(bits->count);
+    for (size_t w = 0; w < bits->words.size(); w++) {
+        uint64_t word = bits->words[w];
+        while (word) {
+            result.push_back(static_cast<int>(w * 64 + std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+    return result;
+}
+
+void PointSelection::prune(const CurveStore& store) {
+    for (uint32_t slot = 0; slot < curves.size(); slot++) {
+        CurveBits& bits = curves[slot];
+        if (bits.count == 0) {
+            continue;
+        }
+        const BezierCurve* curve = store.get(CurveHandle{slot, bits.generation});
+        if (!curve) {
+            total -= bits.count;
+            bits = CurveBits();
+            continue;
+        }
+
+        // Bits au-delà du dernier point
+        size_t pointCount = curve->getControlPointCount();
+        size_t wordCount = (pointCount + 63) >> 6;
+        if (bits.words.size() > wordCount) {
+            bits.words.resize(wordCount);
+        }
+        if (!bits.words.empty() && (pointCount & 63)) {
+            bits.words.back() &= (1ull << (pointCount & 63)) - 1;
+        }
+        size_t count = 0;
+        for (uint64_t word : bits.words) {
+            count += std::popcount(word);
+        }
+        total -= bits.count - count;
+        bits.count = count;
+    }
+}
+
+size_t PointSelection::memoryUsage() const {
+    size_t bytes = sizeof(*this) + curves.capacity() * sizeof(CurveBits);
+    for (const CurveBits& bits : curves) {
+        bytes += bits.words.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
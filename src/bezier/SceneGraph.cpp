@@ -0,0 +1,270 @@
+﻿#include "../../include/bezier/SceneGraph.h"
+#include <algorithm>
+
+SceneGraph::SceneGraph() {
+    clear();
+}
+
+void SceneGraph::clear() {
+    groups.clear();
+    freeGroups.clear();
+    dirtyGroups.clear();
+    curveGroups.clear();
+
+    // Groupe racine : les courbes sans groupe y sont rattachées implicitement
+    Group root;
+    root.name = "Scène";
+    root.alive = true;
+    groups.push_back(root);
+}
+
+SceneGraph::GroupId SceneGraph::createGroup(GroupId parent, const std::string& name) {
+    if (!isValid(parent)) {
+        parent = ROOT;
+    }
+
+    GroupId id;
+    if (!freeGroups.empty()) {
+        id = freeGroups.back();
+        freeGroups.pop_back();
+        groups[id] = Group();
+    } else {
+        id = static_cast<GroupId>(groups.size());
+        groups.emplace_back();
+    }
+
+    Group& group = groups[id];
+    group.name = name.empty() ? "Groupe " + std::to_string(id) : name;
+    group.parent = parent;
+    group.depth = groups[parent].depth + 1;
+    group.world = groups[parent].world;
+    group.alive = true;
+    groups[parent].children.push_back(id);
+    return id;
+}
+
+void SceneGraph::removeGroup(GroupId group, CurveStore& curves) {
+    if (!isValid(group) || group == ROOT) {
+        return;
+    }
+
+    GroupId parent = groups[group].parent;
+
+    // Rattacher les courbes au parent en conservant leur position
+    std::vector<CurveHandle> orphanCurves = groups[group].curves;
+    for (CurveHandle curve : orphanCurves) {
+        // Une courbe supprimée entre-temps n'est pas rattachée, son entrée disparaît avec le groupe
+        removeCurve(curve);
+        addCurve(parent, curve, curves);
+    }
+
+    // Rattacher les sous-groupes : leur matrice locale absorbe celle du groupe supprimé
+    for (GroupId child : groups[group].children) {
+        groups[child].parent = parent;
+        groups[child].local = groups[group].local * groups[child].local;
+        groups[parent].children.push_back(child);
+        setDepth(child, groups[parent].depth + 1);
+    }
+
+    auto& siblings = groups[parent].children;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), group), siblings.end());
+
+    groups[group] = Group();
+    freeGroups.push_back(group);
+}
+
+bool SceneGraph::isValid(GroupId group) const {
+    return group >= 0 && group < static_cast<GroupId>(groups.size()) && groups[group].alive;
+}
+
+SceneGraph::GroupId SceneGraph::getParent(GroupId group) const {
+    return isValid(group) ? groups[group].parent : INVALID_GROUP;
+}
+
+const std::vector<SceneGraph::GroupId>& SceneGraph::getChildren(GroupId group) const {
+    return groups[group].children;
+}
+
+const std::vector<CurveHandle>& SceneGraph::getCurves(GroupId group) const {
+    return groups[group].curves;
+}
+
+const std::string& SceneGraph::getName(GroupId group) const {
+    return groups[group].name;
+}
+
+size_t SceneGraph::getGroupCount() const {
+    return groups.size() - freeGroups.size() - 1; // sans la racine
+}
+
+void SceneGraph::addCurve(GroupId group, CurveHandle curve, CurveStore& curves) {
+    BezierCurve* bezierCurve = curves.get(curve);
+    if (!isValid(group) || !bezierCurve) {
+        return;
+    }
+
+    removeCurve(curve);
+    // Entrée d'une courbe supprimée dont l'emplacement a été réutilisé par celle-ci
+    auto stale = curveGroups.find(curve.index);
+    if (stale != curveGroups.end()) {
+        auto& staleCurves = groups[stale->second.group].curves;
+        staleCurves.erase(std::remove(staleCurves.begin(), staleCurves.end(),
+                                      CurveHandle{curve.index, stale->second.generation}), staleCurves.end());
+        curveGroups.erase(stale);
+    }
+
+    // Exprimer la transformation propre de la courbe dans le repère du nouveau groupe
+    // pour qu'elle ne bouge pas : nouveauMonde^-1 * ancienMonde
+    const Affine2D& newWorld = groups[group].world;
+    Affine2D oldWorld = bezierCurve->getParentTransform();
+    bezierCurve->applyTransform(newWorld.inverse() * oldWorld);
+    bezierCurve->setParentTransform(newWorld);
+
+    if (group != ROOT) {
+        groups[group].curves.push_back(curve);
+        curveGroups[curve.index] = {curve.generation, group};
+    }
+}
+
+void SceneGraph::removeCurve(CurveHandle curve) {
+    auto it = curveGroups.find(curve.index);
+    if (it == curveGroups.end() || it->second.generation != curve.generation) {
+        return;
+    }
+
+    auto& groupCurves = groups[it->second.group].curves;
+    groupCurves.erase(std::remove(groupCurves.begin(), groupCurves.end(), curve), groupCurves.end());
+    curveGroups.erase(it);
+}
+
+SceneGraph::GroupId SceneGraph::groupOf(CurveHandle curve) const {
+    auto it = curveGroups.find(curve.index);
+    return it != curveGroups.end() && it->second.generation == curve.generation ? it->second.group : ROOT;
+}
+
+void SceneGraph::setLocalTransform(GroupId group, const Affine2D& m) {
+    if (!isValid(group)) return;
+    groups[group].local = m;
+    markDirty(group);
+}
+
+const Affine2D& SceneGraph::getLocalTransform(GroupId group) const {
+    return groups[group].local;
+}
+
+void SceneGraph::applyTransform(GroupId group, const Affine2D& m) {
+    if (!isValid(group)) return;
+    groups[group].local = m * groups[group].local;
+    markDirty(group);
+}
+
+void SceneGraph::applyWorldTransform(GroupId group, const Affine2D& m) {
+    if (!isValid(group)) return;
+    if (group == ROOT) {
+        applyTransform(group, m);
+        return;
+    }
+    // Le parent est à jour tant que update() est appelé une fois par image
+    const Affine2D& parentWorld = groups[groups[group].parent].world;
+    applyTransform(group, parentWorld.inverse() * m * parentWorld);
+}
+
+const Affine2D& SceneGraph::getWorldTransform(GroupId group) const {
+    return groups[group].world;
+}
+
+bool SceneGraph::getBounds(GroupId group, const CurveStore& curves, Point& minPoint, Point& maxPoint) const {
+    if (!isValid(group)) {
+        return false;
+    }
+
+    bool found = false;
+    auto merge = [&](const Point& curveMin, const Point& curveMax) {
+        if (!found) {
+            minPoint = curveMin;
+            maxPoint = curveMax;
+            found = true;
+        } else {
+            minPoint.x = std::min(minPoint.x, curveMin.x);
+            minPoint.y = std::min(minPoint.y, curveMin.y);
+            maxPoint.x = std::max(maxPoint.x, curveMax.x);
+            maxPoint.y = std::max(maxPoint.y, curveMax.y);
+        }
+    };
+
+    for (CurveHandle handle : groups[group].curves) {
+        const BezierCurve* curve = curves.get(handle);
+        Point curveMin, curveMax;
+        if (curve && curve->getBounds(curveMin, curveMax)) {
+            merge(curveMin, curveMax);
+        }
+    }
+    for (GroupId child : groups[group].children) {
+        Point childMin, childMax;
+        if (getBounds(child, curves, childMin, childMax)) {
+            merge(childMin, childMax);
+        }
+    }
+    return found;
+}
+
+void SceneGraph::markDirty(GroupId group) {
+    if (!groups[group].dirty) {
+        groups[group].dirty = true;
+        dirtyGroups.push_back(group);
+    }
+}
+
+int SceneGraph::update(CurveStore& curves) {
+    if (dirtyGroups.empty()) {
+        return 0;
+    }
+
+    // Traiter les groupes les moins profonds d'abord : un sous-arbre déjà recalculé
+    // via un ancêtre n'est plus marqué sale et est ignoré
+    std::sort(dirtyGroups.begin(), dirtyGroups.end(), [this](GroupId a, GroupId b) {
+        return groups[a].depth < groups[b].depth;
+    });
+
+    int updated = 0;
+    for (GroupId group : dirtyGroups) {
+        if (isValid(group) && groups[group].dirty) {
+            updateSubtree(group, curves, updated);
+        }
+    }
+    dirtyGroups.clear();
+    return updated;
+}
+
+void SceneGraph::updateSubtree(GroupId group, CurveStore& curves, int& updated) {
+    Group& node = groups[group];
+    node.world = node.parent == INVALID_GROUP ? node.local : groups[node.parent].world * node.local;
+    node.dirty = false;
+    updated++;
+
+    // La racine transmet aussi sa matrice aux courbes sans groupe
+    if (group == ROOT) {
+        for (auto& curve : curves) {
+            if (groupOf(curves.handleOf(&curve)) == ROOT) {
+                curve.setParentTransform(node.world);
+            }
+        }
+    } else {
+        for (CurveHandle handle : node.curves) {
+            if (BezierCurve* curve = curves.get(handle)) {
+                curve->setParentTransform(node.world);
+            }
+        }
+    }
+
+    for (GroupId child : node.children) {
+        updateSubtree(child, curves, updated);
+    }
+}
+
+void SceneGraph::setDepth(GroupId group, int depth) {
+    groups[group].depth = depth;
+    for (GroupId child : groups[group].children) {
+        setDepth(child, depth + 1);
+    }
+}
@@ -0,0 +1,95 @@
+﻿#include "../../include/bezier/SnapEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+SnapEngine::SnapEngine()
+        : enabled(false), radius(0.03f), gridSpacing(0.1f), lastQueryMs(0.0) {
+    targetEnabled.fill(true);
+    // Les cibles exactes passent avant les cibles continues, la grille en dernier
+    for (int i = 0; i < TARGET_COUNT; i++) {
+        priority[i] = i;
+    }
+    sortTargets();
+}
+
+void SnapEngine::setProvider(Target target, Provider provider) {
+    providers[index(target)] = std::move(provider);
+}
+
+void SnapEngine::setPriority(Target target, int value) {
+    priority[index(target)] = value;
+    sortTargets();
+}
+
+void SnapEngine::sortTargets() {
+    for (int i = 0; i < TARGET_COUNT; i++) {
+        order[i] = static_cast<Target>(i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [this](Target a, Target b) { return priority[index(a)] < priority[index(b)]; });
+}
+
+bool SnapEngine::snap(const Point& p, Snap& result) {
+    if (!enabled) {
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bool found = false;
+    for (Target target : order) {
+        if (!targetEnabled[index(target)]) {
+            continue;
+        }
+
+        Snap candidate;
+        candidate.target = target;
+        if (target == Target::GRID) {
+            found = snapToGrid(p, candidate);
+        } else if (providers[index(target)]) {
+            found = providers[index(target)](p, radius, candidate);
+        }
+
+        if (found) {
+            candidate.target = target;
+            candidate.distance = candidate.point.distanceTo(p);
+            result = candidate;
+            break;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastQueryMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return found;
+}
+
+bool SnapEngine::snapToGrid(const Point& p, Snap& result) const {
+    if (gridSpacing <= 0.0f) {
+        return false;
+    }
+    Point node(std::round(p.x / gridSpacing) * gridSpacing, std::round(p.y / gridSpacing) * gridSpacing);
+    float dx = node.x - p.x;
+    float dy = node.y - p.y;
+    if (dx * dx + dy * dy >= radius * radius) {
+        return false;
+    }
+    result.point = node;
+    return true;
+}
+
+const char* SnapEngine::getTargetName(Target target) {
+    switch (target) {
+        case Target::CONTROL_POINT:
+            return "Points de contrôle";
+        case Target::CLIP_VERTEX:
+            return "Sommets de la fenêtre";
+        case Target::CURVE:
+            return "Courbes";
+        case Target::CLIP_EDGE:
+            return "Arêtes de la fenêtre";
+        case Target::GRID:
+            return "Grille";
+        default:
+            return "Inconnu";
+    }
+}
@@ -0,0 +1,108 @@
+﻿#include "../../include/clipping/ClipWindow.h"
+#include "../../include/clipping/CyriusBeck.h"
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    // Versions partagées par toutes les fenêtres : deux états distincts n'ont jamais la même
+    std::atomic<uint64_t> nextVersion{1};
+}
+
+ClipWindow::ClipWindow() : ClipWindow(std::vector<Point>()) {}
+
+ClipWindow::ClipWindow(std::vector<Point> vertices)
+        : vertices(std::move(vertices)), version(0), convex(false), counterClockwise(true) {
+    rebuild();
+}
+
+void ClipWindow::addVertex(const Point& p) {
+    vertices.push_back(p);
+    rebuild();
+}
+
+void ClipWindow::moveVertex(int index, const Point& p) {
+    if (index < 0 || index >= static_cast<int>(vertices.size())) {
+        return;
+    }
+    vertices[index] = p;
+    rebuild();
+}
+
+void ClipWindow::removeVertex(int index) {
+    if (index < 0 || index >= static_cast<int>(vertices.size())) {
+        return;
+    }
+    vertices.erase(vertices.begin() + index);
+    rebuild();
+}
+
+void ClipWindow::clear() {
+    vertices.clear();
+    rebuild();
+}
+
+ClipWindow ClipWindow::transformed(const Affine2D& m) const {
+    std::vector<Point> image;
+    image.reserve(vertices.size());
+    for (const Point& p : vertices) {
+        image.push_back(m.apply(p));
+    }
+
+    // Une symétrie inverse l'orientation de la fenêtre
+    if (m.determinant() < 0.0f) {
+        std::reverse(image.begin(), image.end());
+    }
+
+    ClipWindow window(std::move(image));
+    window.version = version;
+    return window;
+}
+
+void ClipWindow::rebuild() {
+    version = nextVersion++;
+
+    normalX.clear();
+    normalY.clear();
+    offsets.clear();
+    bounds = AABB::fromPoints(vertices);
+    convex = CyrusBeck::isPolygonConvex(vertices);
+
+    const size_t count = vertices.size();
+    if (count < 3) {
+        counterClockwise = true;
+        return;
+    }
+
+    // Sens de parcours (aire signée) : la normale à droite de chaque arête est sortante pour
+    // un parcours anti-horaire, elle est retournée pour un parcours horaire
+    float area = 0.0f;
+    for (size_t j = 0; j < count; j++) {
+        const Point& a = vertices[j];
+        const Point& b = vertices[(j + 1) % count];
+        area += a.x * b.y - a.y * b.x;
+    }
+    counterClockwise = area >= 0.0f;
+    const float orientation = counterClockwise ? 1.0f : -1.0f;
+
+    normalX.reserve(count);
+    normalY.reserve(count);
+    offsets.reserve(count);
+    for (size_t j = 0; j < count; j++) {
+        const Point& e1 = vertices[j];
+        const Point& e2 = vertices[(j + 1) % count];
+
+        float nx = (e2.y - e1.y) * orientation;
+        float ny = -(e2.x - e1.x) * orientation;
+        float length = std::sqrt(nx * nx + ny * ny);
+        if (length <= 0.0f) {
+            continue; // sommets confondus : pas d'arête
+        }
+        nx /= length;
+        ny /= length;
+
+        normalX.push_back(nx);
+        normalY.push_back(ny);
+        offsets.push_back(nx * e1.x + ny * e1.y);
+    }
+}
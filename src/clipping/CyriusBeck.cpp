@@ -1,6 +1,104 @@
 ﻿#include "../../include/clipping/CyriusBeck.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CYRUS_BECK_SSE2 1
+#endif
+
+namespace {
+    constexpr float PARALLEL_EPSILON = 1e-6f;
+
+    // Découpe les LANES segments d'un bloc par toutes les arêtes de la fenêtre. tE ne fait que
+    // croître depuis 0 et tL décroître depuis 1 : une arête qui ne contraint pas un segment
+    // propose 0 ou 1, un segment parallèle à l'arête et à l'extérieur est rejeté (tL = -1).
+    // Retourne false dès que tous les segments du bloc sont rejetés.
+#ifdef CYRUS_BECK_SSE2
+    inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    bool clipBlock(const ClipWindow& window,
+                   const float* x0, const float* y0, const float* dx, const float* dy, float* tE, float* tL) {
+        static_assert(CyrusBeck::LANES == 8, "deux registres de 4 voies par bloc");
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        const __m128 epsilon = _mm_set1_ps(PARALLEL_EPSILON);
+        const __m128 minusEpsilon = _mm_set1_ps(-PARALLEL_EPSILON);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        __m128 px[2] = {_mm_loadu_ps(x0), _mm_loadu_ps(x0 + 4)};
+        __m128 py[2] = {_mm_loadu_ps(y0), _mm_loadu_ps(y0 + 4)};
+        __m128 vx[2] = {_mm_loadu_ps(dx), _mm_loadu_ps(dx + 4)};
+        __m128 vy[2] = {_mm_loadu_ps(dy), _mm_loadu_ps(dy + 4)};
+        __m128 enter[2] = {_mm_loadu_ps(tE), _mm_loadu_ps(tE + 4)};
+        __m128 leave[2] = {_mm_loadu_ps(tL), _mm_loadu_ps(tL + 4)};
+
+        bool visible = true;
+        const float* normalX = window.getNormalX().data();
+        const float* normalY = window.getNormalY().data();
+        const float* offsets = window.getOffsets().data();
+        for (size_t j = 0; j < window.edgeCount() && visible; j++) {
+            const __m128 nx = _mm_set1_ps(normalX[j]);
+            const __m128 ny = _mm_set1_ps(normalY[j]);
+            const __m128 c = _mm_set1_ps(offsets[j]);
+
+            int alive = 0;
+            for (int g = 0; g < 2; g++) {
+                __m128 numerator = _mm_sub_ps(c, _mm_add_ps(_mm_mul_ps(nx, px[g]), _mm_mul_ps(ny, py[g])));
+                __m128 denominator = _mm_add_ps(_mm_mul_ps(nx, vx[g]), _mm_mul_ps(ny, vy[g]));
+
+                __m128 parallel = _mm_cmplt_ps(_mm_andnot_ps(signMask, denominator), epsilon);
+                __m128 t = _mm_div_ps(numerator, select(parallel, one, denominator));
+                __m128 outside = select(_mm_cmplt_ps(numerator, zero), minusOne, one);
+
+                __m128 entering = _mm_cmple_ps(denominator, minusEpsilon);
+                __m128 leaving = _mm_cmpge_ps(denominator, epsilon);
+                enter[g] = _mm_max_ps(enter[g], _mm_and_ps(entering, t));
+                leave[g] = _mm_min_ps(leave[g], select(leaving, t, select(parallel, outside, one)));
+                alive |= _mm_movemask_ps(_mm_cmple_ps(enter[g], leave[g]));
+            }
+            // Tous les segments du bloc sont rejetés : arêtes suivantes inutiles
+            visible = alive != 0;
+        }
+
+        _mm_storeu_ps(tE, enter[0]);
+        _mm_storeu_ps(tE + 4, enter[1]);
+        _mm_storeu_ps(tL, leave[0]);
+        _mm_storeu_ps(tL + 4, leave[1]);
+        return visible;
+    }
+#else
+    bool clipBlock(const ClipWindow& window,
+                   const float* x0, const float* y0, const float* dx, const float* dy, float* tE, float* tL) {
+        bool visible = true;
+        const float* normalX = window.getNormalX().data();
+        const float* normalY = window.getNormalY().data();
+        const float* offsets = window.getOffsets().data();
+        for (size_t j = 0; j < window.edgeCount() && visible; j++) {
+            const float nx = normalX[j], ny = normalY[j], c = offsets[j];
+            visible = false;
+            for (int l = 0; l < CyrusBeck::LANES; l++) {
+                float numerator = c - (nx * x0[l] + ny * y0[l]);
+                float denominator = nx * dx[l] + ny * dy[l];
+
+                bool parallel = std::abs(denominator) < PARALLEL_EPSILON;
+                float t = numerator / (parallel ? 1.0f : denominator);
+                float outside = numerator < 0.0f ? -1.0f : 1.0f;
+                float enter = denominator <= -PARALLEL_EPSILON ? t : 0.0f;
+                float leave = denominator >= PARALLEL_EPSILON ? t : (parallel ? outside : 1.0f);
+                tE[l] = std::max(tE[l], enter);
+                tL[l] = std::min(tL[l], leave);
+                visible = visible || tE[l] <= tL[l];
+            }
+        }
+        return visible;
+    }
+#endif
+}
 
 bool CyrusBeck::isPolygonConvex(const std::vector<Point>& polygon) {
     // Un polygone avec moins de 3 points n'est pas considéré comme convexe
@@ -46,48 +144,89 @@ float CyrusBeck::dotProduct(const Point& a, const Point& b) {
     return a.x * b.x + a.y * b.y;
 }
 
-bool CyrusBeck::clipSegmentToEdge(const Point& p1, const Point& p2, const Point& e1, const Point& e2,
-                                 float& tE, float& tL, Point& normal) {
-    // Vecteur du segment
-    Point d(p2.x - p1.x, p2.y - p1.y);
-
-    // Vecteur normal à l'arête (e1, e2)
-    normal.x = e2.y - e1.y;
-    normal.y = -(e2.x - e1.x);
-
-    // Normaliser le vecteur normal
-    float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
-    if (length > 0) {
-        normal.x /= length;
-        normal.y /= length;
+void CyrusBeck::clipPolyline(std::span<const Point> curve, const ClipWindow& window, ClippedPolylines& out) {
+    if (curve.size() < 2 || window.edgeCount() < 3 || !window.isConvex()) {
+        return;
     }
 
-    // Produit scalaire entre le vecteur du segment et le vecteur normal
-    float numerator = dotProduct(normal, Point(e1.x - p1.x, e1.y - p1.y));
-    float denominator = dotProduct(normal, d);
+    const size_t segmentCount = curve.size() - 1;
+    const size_t edgeCount = window.edgeCount();
+    const float* normalX = window.getNormalX().data();
+    const float* normalY = window.getNormalY().data();
+    const float* offset = window.getOffsets().data();
+
+    const AABB& bounds = window.getBounds();
+    const float windowMinX = bounds.min.x, windowMinY = bounds.min.y;
+    const float windowMaxX = bounds.max.x, windowMaxY = bounds.max.y;
+
+    alignas(32) float x0[LANES], y0[LANES], dx[LANES], dy[LANES], tE[LANES], tL[LANES];
+    // Dernier segment dont la fin est restée visible (tL = 1) : le suivant peut prolonger son tracé
+    size_t openSegment = SIZE_MAX;
+
+    for (size_t first = 0; first < segmentCount; first += LANES) {
+        const int lanes = static_cast<int>(std::min<size_t>(LANES, segmentCount - first));
+
+        // Chargement du bloc ; les voies inutilisées sont rejetées d'avance (tE > tL)
+        float minX = curve[first].x, maxX = minX;
+        float minY = curve[first].y, maxY = minY;
+        for (int l = 0; l < LANES; l++) {
+            if (l < lanes) {
+                const Point& p1 = curve[first + l];
+                const Point& p2 = curve[first + l + 1];
+                x0[l] = p1.x;
+                y0[l] = p1.y;
+                dx[l] = p2.x - p1.x;
+                dy[l] = p2.y - p1.y;
+                tE[l] = 0.0f;
+                tL[l] = 1.0f;
+                minX = std::min(minX, p2.x);
+                maxX = std::max(maxX, p2.x);
+                minY = std::min(minY, p2.y);
+                maxY = std::max(maxY, p2.y);
+            } else {
+                x0[l] = y0[l] = dx[l] = dy[l] = 0.0f;
+                tE[l] = 0.0f;
+                tL[l] = -1.0f;
+            }
+        }
 
-    // Segment parallèle à l'arête
-    if (std::abs(denominator) < 1e-6) {
-        // Si le segment est à l'extérieur de l'arête, il est rejeté
-        if (numerator < 0) {
-            return false;
+        // Bloc entièrement hors de la boîte de la fenêtre : aucun segment visible
+        if (maxX < windowMinX || minX > windowMaxX || maxY < windowMinY || minY > windowMaxY) {
+            continue;
+        }
+
+        // Classement de la boîte du bloc par arête : entièrement à l'extérieur d'une arête, tous
+        // les segments sont rejetés ; à l'intérieur de toutes, ils sont visibles en entier
+        // (tE = 0, tL = 1). Seuls les blocs à cheval sur le bord passent par le calcul par voie.
+        bool outside = false, inside = true;
+        for (size_t j = 0; j < edgeCount && !outside; j++) {
+            const float nx = normalX[j], ny = normalY[j];
+            float nearest = nx * (nx > 0.0f ? minX : maxX) + ny * (ny > 0.0f ? minY : maxY);
+            float farthest = nx * (nx > 0.0f ? maxX : minX) + ny * (ny > 0.0f ? maxY : minY);
+            outside = nearest > offset[j];
+            inside = inside && farthest <= offset[j];
+        }
+        if (outside) {
+            continue;
         }
-        // Sinon, le segment est parallèle et à l'intérieur, pas de découpage
-        return true;
-    }
 
-    // Calculer le paramètre t d'intersection
-    float t = numerator / denominator;
+        if (!inside && !clipBlock(window, x0, y0, dx, dy, tE, tL)) {
+            continue;
+        }
 
-    // Mettre à jour tE et tL en fonction du signe de denominator
-    if (denominator < 0) {
-        tE = std::max(tE, t);
-    } else {
-        tL = std::min(tL, t);
+        for (int l = 0; l < lanes; l++) {
+            if (tE[l] > tL[l]) {
+                continue;
+            }
+            // Les extrémités non découpées reprennent exactement les sommets de la courbe
+            const size_t segment = first + l;
+            if (tE[l] != 0.0f || segment == 0 || openSegment != segment - 1) {
+                out.beginRun(tE[l] == 0.0f ? curve[segment] : Point(x0[l] + tE[l] * dx[l], y0[l] + tE[l] * dy[l]));
+            }
+            out.extendRun(tL[l] == 1.0f ? curve[segment + 1] : Point(x0[l] + tL[l] * dx[l], y0[l] + tL[l] * dy[l]));
+            openSegment = tL[l] == 1.0f ? segment : SIZE_MAX;
+        }
     }
-
-    // Si tE > tL, le segment est complètement à l'extérieur
-    return tE <= tL;
 }
 
 std::vector<std::vector<Point>> CyrusBeck::clipCurveToWindow(const std::vector<Point>& curve, const std::vector<Point>& clipWindow) {
@@ -98,45 +237,8 @@ std::vector<std::vector<Point>> CyrusBeck::clipCurveToWindow(const std::vector<P
         return clippedSegments;
     }
 
-    // Traiter chaque segment de la courbe
-    for (size_t i = 0; i < curve.size() - 1; i++) {
-        Point p1 = curve[i];
-        Point p2 = curve[i + 1];
-
-        // Paramètres pour l'algorithme de Cyrus-Beck
-        float tE = 0.0f;  // Paramètre d'entrée
-        float tL = 1.0f;  // Paramètre de sortie
-
-        bool visible = true;
-
-        // Vérifier chaque arête de la fenêtre de découpage
-        for (size_t j = 0; j < clipWindow.size(); j++) {
-            size_t nextJ = (j + 1) % clipWindow.size();
-            Point e1 = clipWindow[j];
-            Point e2 = clipWindow[nextJ];
-
-            Point normal;
-
-            // Découper le segment par rapport à cette arête
-            if (!clipSegmentToEdge(p1, p2, e1, e2, tE, tL, normal)) {
-                visible = false;
-                break;
-            }
-        }
-
-        // Si le segment est visible (au moins partiellement)
-        if (visible && tE <= tL) {
-            // Calculer les points découpés
-            Point clippedP1(p1.x + tE * (p2.x - p1.x), p1.y + tE * (p2.y - p1.y));
-            Point clippedP2(p1.x + tL * (p2.x - p1.x), p1.y + tL * (p2.y - p1.y));
-
-            // Ajouter le segment découpé
-            std::vector<Point> segment;
-            segment.push_back(clippedP1);
-            segment.push_back(clippedP2);
-            clippedSegments.push_back(segment);
-        }
-    }
-
-    return clippedSegments;
-}
\ No newline at end of file
+    // Normales et décalages des arêtes calculés une seule fois pour tous les segments
+    ClippedPolylines polylines;
+    clipPolyline(curve, ClipWindow(clipWindow), polylines);
+    return polylines.toRuns();
+}
@@ -0,0 +1,394 @@
+﻿#include "../../include/clipping/GreinerHormann.h"
+#include "../../include/commons/DynamicAABBTree.h"
+#include <algorithm>
+
+namespace {
+    float cross(float ax, float ay, float bx, float by) {
+        return ax * by - ay * bx;
+    }
+
+    bool samePoint(const Point& a, const Point& b) {
+        return a.x == b.x && a.y == b.y;
+    }
+
+    AABB segmentBox(const Point& a, const Point& b) {
+        return AABB(Point(std::min(a.x, b.x), std::min(a.y, b.y)), Point(std::max(a.x, b.x), std::max(a.y, b.y)));
+    }
+
+    Point lerp(const Point& a, const Point& b, float t) {
+        return Point(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y));
+    }
+
+    // Perturbation symbolique : le sujet est décalé de d = (ε, ε²) par rapport à la fenêtre, si
+    // bien qu'aucun de ses points n'est exactement sur un bord. value = cross(e, w) est évalué
+    // exactement ; s'il est nul, son signe est celui de cross(e, direction * d).
+    bool positive(float value, float ex, float ey, float direction) {
+        if (value != 0.0f) {
+            return value > 0.0f;
+        }
+        return (ey != 0.0f ? -ey : ex) * direction > 0.0f;
+    }
+
+    // Intersection du segment [p, q] du sujet et de l'arête [a, b] de la fenêtre, aux paramètres
+    // t sur le segment et u sur l'arête. Avec la perturbation, un sommet partagé par deux arêtes
+    // n'est compté qu'une fois et un simple contact sans traversée ne l'est pas. Un point
+    // exactement sur l'autre droite est repris tel quel dans hit.
+    bool crossing(const Point& p, const Point& q, const Point& a, const Point& b, float& t, float& u, Point& hit) {
+        const float dx = q.x - p.x, dy = q.y - p.y;
+        const float sa = cross(dx, dy, a.x - p.x, a.y - p.y);
+        const float sb = cross(dx, dy, b.x - p.x, b.y - p.y);
+        // Vue depuis le sujet, la fenêtre est décalée de -d
+        if (positive(sa, dx, dy, -1.0f) == positive(sb, dx, dy, -1.0f)) {
+            return false;
+        }
+
+        const float ex = b.x - a.x, ey = b.y - a.y;
+        const float sp = cross(ex, ey, p.x - a.x, p.y - a.y);
+        const float sq = cross(ex, ey, q.x - a.x, q.y - a.y);
+        if (positive(sp, ex, ey, 1.0f) == positive(sq, ex, ey, 1.0f)) {
+            return false;
+        }
+
+        t = sp / (sp - sq);
+        u = sa / (sa - sb);
+        hit = sp == 0.0f ? p : sq == 0.0f ? q : sa == 0.0f ? a : sb == 0.0f ? b : lerp(p, q, t);
+        return true;
+    }
+
+    // Règle pair-impair : parité du nombre d'arêtes coupées par le rayon horizontal issu de p
+    // décalé de direction * d, avec les mêmes conventions que crossing
+    bool crossesRay(const Point& a, const Point& b, const Point& p, float direction) {
+        const bool aAbove = direction > 0.0f ? a.y > p.y : a.y >= p.y;
+        const bool bAbove = direction > 0.0f ? b.y > p.y : b.y >= p.y;
+        if (aAbove == bAbove) {
+            return false;
+        }
+        const float ex = b.x - a.x, ey = b.y - a.y;
+        return positive(cross(ex, ey, p.x - a.x, p.y - a.y), ex, ey, direction) == bAbove;
+    }
+
+    // Point de la fenêtre dans les contours du sujet
+    bool containsEvenOdd(const GreinerHormann::Contours& contours, const Point& p) {
+        bool inside = false;
+        for (const auto& ring : contours) {
+            if (ring.size() < 3) {
+                continue;
+            }
+            for (size_t j = 0; j < ring.size(); j++) {
+                if (crossesRay(ring[j], ring[(j + 1) % ring.size()], p, -1.0f)) {
+                    inside = !inside;
+                }
+            }
+        }
+        return inside;
+    }
+
+    // Arêtes d'un ensemble de contours, indexées par leurs boîtes. Les arêtes d'un contour sont
+    // consécutives et rangées dans son sens de parcours.
+    class EdgeIndex {
+    public:
+        struct Edge {
+            Point a, b;
+        };
+
+        explicit EdgeIndex(const GreinerHormann::Contours& contours) : maxX(0.0f), tree(0.0f) {
+            for (const auto& ring : contours) {
+                ringFirstEdge.push_back(static_cast<int>(edges.size()));
+                if (ring.size() < 3) {
+                    continue;
+                }
+                for (size_t j = 0; j < ring.size(); j++) {
+                    const Point& a = ring[j];
+                    const Point& b = ring[(j + 1) % ring.size()];
+                    maxX = edges.empty() ? std::max(a.x, b.x) : std::max(maxX, std::max(a.x, b.x));
+                    tree.createProxy(segmentBox(a, b), static_cast<int>(edges.size()));
+                    edges.push_back({a, b});
+                }
+            }
+            ringFirstEdge.push_back(static_cast<int>(edges.size()));
+        }
+
+        bool empty() const { return edges.empty(); }
+        const Edge& edge(int id) const { return edges[id]; }
+        int ringEdgeBegin(size_t ring) const { return ringFirstEdge[ring]; }
+        int ringEdgeEnd(size_t ring) const { return ringFirstEdge[ring + 1]; }
+
+        // callback(id, arête) pour chaque arête dont la boîte touche area
+        template <typename Callback>
+        void query(const AABB& area, Callback callback) const {
+            tree.queryBox(area, [&](int proxyId) {
+                int id = tree.getUserData(proxyId);
+                callback(id, edges[id]);
+                return true;
+            });
+        }
+
+        // Point du sujet dans la fenêtre, limité aux arêtes que le rayon peut couper
+        bool contains(const Point& p) const {
+            bool inside = false;
+            if (p.x >= maxX) {
+                return inside;
+            }
+            query(AABB(p, Point(maxX, p.y)), [&](int, const Edge& e) {
+                if (crossesRay(e.a, e.b, p, 1.0f)) {
+                    inside = !inside;
+                }
+            });
+            return inside;
+        }
+
+    private:
+        std::vector<Edge> edges;
+        std::vector<int> ringFirstEdge; // arêtes du contour r : [ringFirstEdge[r], ringFirstEdge[r + 1][
+        float maxX;
+        DynamicAABBTree tree;
+    };
+
+    // Sommet des listes de Greiner-Hormann : sommet d'origine, ou intersection quand il est
+    // relié à son double dans l'autre liste (neighbor)
+    struct Vertex {
+        Point p;
+        int next = -1, prev = -1;
+        int neighbor = -1;
+        bool entry = false;
+        bool visited = false;
+    };
+
+    // Chaîne circulairement les sommets [begin, end[ d'un contour
+    void linkRing(std::vector<Vertex>& list, int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            list[i].next = i + 1 < end ? i + 1 : begin;
+            list[i].prev = i > begin ? i - 1 : end - 1;
+        }
+    }
+
+    // Marque chaque intersection d'un contour comme entrée dans l'autre région ou sortie, à partir
+    // de l'état de son premier sommet. Retourne false si le contour n'a aucune intersection.
+    bool markEntries(std::vector<Vertex>& list, int begin, int end, bool inside) {
+        bool crossed = false;
+        for (int i = begin; i < end; i++) {
+            if (list[i].neighbor != -1) {
+                list[i].entry = !inside;
+                inside = !inside;
+                crossed = true;
+            }
+        }
+        return crossed;
+    }
+}
+
+void GreinerHormann::clipPolyline(std::span<const Point> curve, const Contours& window, ClippedPolylines& out) {
+    if (curve.size() < 2) {
+        return;
+    }
+    EdgeIndex edges(window);
+    if (edges.empty()) {
+        return;
+    }
+
+    // Chaque traversée du bord fait passer de l'intérieur à l'extérieur ou inversement : seul
+    // l'état du premier point est testé, avec la même perturbation que les traversées, et les
+    // tracés se prolongent d'un segment au suivant
+    struct Crossing {
+        float t;
+        Point p;
+    };
+    std::vector<Crossing> crossings;
+    bool inside = edges.contains(curve[0]);
+    if (inside) {
+        out.beginRun(curve[0]);
+    }
+
+    // Un point déjà en fin de tracé (sommet du bord, point de la courbe sur le bord) n'est pas
+    // répété, et un tracé réduit à ce seul point (passage par un coin) est retiré
+    auto extend = [&](const Point& p) {
+        if (!samePoint(out.vertices.back(), p)) {
+            out.extendRun(p);
+        }
+    };
+    auto dropPointRun = [&]() {
+        if (out.count.back() < 2) {
+            out.vertices.pop_back();
+            out.first.pop_back();
+            out.count.pop_back();
+        }
+    };
+
+    for (size_t i = 0; i + 1 < curve.size(); i++) {
+        const Point& p = curve[i];
+        const Point& q = curve[i + 1];
+
+        crossings.clear();
+        edges.query(segmentBox(p, q), [&](int, const EdgeIndex::Edge& e) {
+            float t, u;
+            Point hit;
+            if (crossing(p, q, e.a, e.b, t, u, hit)) {
+                crossings.push_back({t, hit});
+            }
+        });
+        std::sort(crossings.begin(), crossings.end(), [](const Crossing& a, const Crossing& b) { return a.t < b.t; });
+
+        for (size_t k = 0; k < crossings.size(); k++) {
+            // Sortie et retour par le même sommet du bord : l'état ne change pas
+            if (k + 1 < crossings.size() && samePoint(crossings[k].p, crossings[k + 1].p)) {
+                k++;
+                continue;
+            }
+            if (inside) {
+                extend(crossings[k].p);
+                dropPointRun();
+            } else {
+                out.beginRun(crossings[k].p);
+            }
+            inside = !inside;
+        }
+        if (inside) {
+            extend(q);
+        }
+    }
+
+    if (inside) {
+        dropPointRun();
+    }
+}
+
+void GreinerHormann::clipPolyline(std::span<const Point> curve, const ClipWindow& window, ClippedPolylines& out) {
+    clipPolyline(curve, Contours{window.getVertices()}, out);
+}
+
+GreinerHormann::Contours GreinerHormann::clipPolygon(const Contours& subject, const Contours& window) {
+    Contours result;
+    // Seules les arêtes de la fenêtre sont indexées : le sujet n'est parcouru qu'une fois, plus
+    // un test pair-impair linéaire par contour de la fenêtre
+    EdgeIndex clipEdges(window);
+    if (clipEdges.empty()) {
+        return result;
+    }
+
+    // lists[0] : contours du sujet, lists[1] : contours de la fenêtre. Les sommets d'un contour
+    // sont consécutifs, [rings[side][r], rings[side][r + 1][.
+    std::vector<Vertex> lists[2];
+    std::vector<int> rings[2];
+
+    // Intersection trouvée le long du sujet, rangée ensuite le long de l'arête de la fenêtre
+    struct Hit {
+        float t, u;
+        Point p;
+        int edge;
+        int vertex; // dans lists[0]
+    };
+    std::vector<Hit> hits, edgeHits;
+
+    // Sujet : sommets d'origine et intersections dans l'ordre de parcours
+    for (const auto& ring : subject) {
+        rings[0].push_back(static_cast<int>(lists[0].size()));
+        if (ring.size() < 3) {
+            continue;
+        }
+        for (size_t j = 0; j < ring.size(); j++) {
+            const Point& p = ring[j];
+            const Point& q = ring[(j + 1) % ring.size()];
+            lists[0].push_back(Vertex{p});
+
+            edgeHits.clear();
+            clipEdges.query(segmentBox(p, q), [&](int id, const EdgeIndex::Edge& e) {
+                float t, u;
+                Point hit;
+                if (crossing(p, q, e.a, e.b, t, u, hit)) {
+                    edgeHits.push_back({t, u, hit, id, -1});
+                }
+            });
+            std::sort(edgeHits.begin(), edgeHits.end(), [](const Hit& a, const Hit& b) { return a.t < b.t; });
+
+            for (Hit& hit : edgeHits) {
+                hit.vertex = static_cast<int>(lists[0].size());
+                lists[0].push_back(Vertex{hit.p});
+                hits.push_back(hit);
+            }
+        }
+    }
+    rings[0].push_back(static_cast<int>(lists[0].size()));
+
+    // Fenêtre : les mêmes intersections, triées le long de chaque arête
+    std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+        return a.edge != b.edge ? a.edge < b.edge : a.u < b.u;
+    });
+    size_t h = 0;
+    for (size_t r = 0; r < window.size(); r++) {
+        rings[1].push_back(static_cast<int>(lists[1].size()));
+        for (int id = clipEdges.ringEdgeBegin(r); id < clipEdges.ringEdgeEnd(r); id++) {
+            lists[1].push_back(Vertex{clipEdges.edge(id).a});
+            for (; h < hits.size() && hits[h].edge == id; h++) {
+                int vertex = static_cast<int>(lists[1].size());
+                lists[1].push_back(Vertex{lists[0][hits[h].vertex].p});
+                lists[1][vertex].neighbor = hits[h].vertex;
+                lists[0][hits[h].vertex].neighbor = vertex;
+            }
+        }
+    }
+    rings[1].push_back(static_cast<int>(lists[1].size()));
+
+    // Entrées / sorties ; un contour sans intersection est gardé en entier s'il est dans l'autre région
+    for (int side = 0; side < 2; side++) {
+        for (size_t r = 0; r + 1 < rings[side].size(); r++) {
+            const int begin = rings[side][r], end = rings[side][r + 1];
+            if (begin == end) {
+                continue;
+            }
+            linkRing(lists[side], begin, end);
+            const Point& first = lists[side][begin].p;
+            bool inside = side == 0 ? clipEdges.contains(first) : containsEvenOdd(subject, first);
+            if (!markEntries(lists[side], begin, end, inside) && inside) {
+                std::vector<Point> contour;
+                contour.reserve(end - begin);
+                for (int i = begin; i < end; i++) {
+                    contour.push_back(lists[side][i].p);
+                }
+                result.push_back(std::move(contour));
+            }
+        }
+    }
+
+    // Parcours : en avant depuis une entrée, en arrière depuis une sortie, en changeant de
+    // liste à chaque intersection jusqu'à revenir au point de départ
+    for (int start = 0; start < static_cast<int>(lists[0].size()); start++) {
+        if (lists[0][start].neighbor == -1 || lists[0][start].visited) {
+            continue;
+        }
+
+        std::vector<Point> contour{lists[0][start].p};
+        int side = 0, current = start;
+        while (true) {
+            std::vector<Vertex>& list = lists[side];
+            list[current].visited = true;
+            lists[1 - side][list[current].neighbor].visited = true;
+
+            const bool forward = list[current].entry;
+            do {
+                current = forward ? list[current].next : list[current].prev;
+                if (!samePoint(list[current].p, contour.back())) {
+                    contour.push_back(list[current].p);
+                }
+            } while (list[current].neighbor == -1);
+
+            if (list[current].visited) {
+                break;
+            }
+            current = list[current].neighbor;
+            side = 1 - side;
+        }
+
+        if (contour.size() > 1 && samePoint(contour.back(), contour.front())) {
+            contour.pop_back();
+        }
+        if (contour.size() >= 3) {
+            result.push_back(std::move(contour));
+        }
+    }
+
+    return result;
+}
+
+GreinerHormann::Contours GreinerHormann::clipPolygon(std::span<const Point> subject, const ClipWindow& window) {
+    return clipPolygon(Contours{std::vector<Point>(subject.begin(), subject.end())}, Contours{window.getVertices()});
+}
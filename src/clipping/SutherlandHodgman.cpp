@@ -1,72 +1,125 @@
 ﻿
 #include "../../include/clipping/SutherlandHodgman.h"
+#include "../../include/commons/ParallelFor.h"
+#include <algorithm>
 
-bool SutherlandHodgman::isInside(const Point& p, const Point& p1, const Point& p2) {
-    return (p2.x - p1.x) * (p.y - p1.y) - (p2.y - p1.y) * (p.x - p1.x) >= 0;
+namespace {
+    // En dessous de ce nombre de sommets par thread, le coût de création des threads domine
+    constexpr size_t MIN_POINTS_PER_THREAD = 16384;
 }
 
-Point SutherlandHodgman::computeIntersection(const Point& s, const Point& e, const Point& p1, const Point& p2) {
-    float dc[2], dp[2];
-    dc[0] = p1.x - p2.x;
-    dc[1] = p1.y - p2.y;
-    dp[0] = s.x - e.x;
-    dp[1] = s.y - e.y;
-
-    float n1 = p1.x * p2.y - p1.y * p2.x;
-    float n2 = s.x * e.y - s.y * e.x;
-    float n3 = 1.0f / (dc[0] * dp[1] - dc[1] * dp[0]);
-
-    return Point((n1 * dp[0] - n2 * dc[0]) * n3, (n1 * dp[1] - n2 * dc[1]) * n3);
+std::vector<Point> SutherlandHodgman::clipPolygon(const std::vector<Point>& subjectPolygon, const std::vector<Point>& clipPolygon) {
+    return SutherlandHodgman::clipPolygon(subjectPolygon, ClipWindow(clipPolygon));
 }
 
-std::vector<Point> SutherlandHodgman::clipPolygon(const std::vector<Point>& subjectPolygon, const std::vector<Point>& clipPolygon) {
-    std::vector<Point> outputList = subjectPolygon;
+std::vector<Point> SutherlandHodgman::clipPolygon(std::span<const Point> subjectPolygon, const ClipWindow& window) {
+    Scratch scratch;
+    return clipPolygon(subjectPolygon, window, scratch);
+}
 
-    // Pour chaque arête du polygone de découpage
-    for (int i = 0; i < clipPolygon.size(); i++) {
-        int nextI = (i + 1) % clipPolygon.size();
-        const Point& clipEdgeStart = clipPolygon[i];
-        const Point& clipEdgeEnd = clipPolygon[nextI];
+const std::vector<Point>& SutherlandHodgman::clipPolygon(std::span<const Point> subjectPolygon, const ClipWindow& window,
+                                                         Scratch& scratch) {
+    const size_t edgeCount = window.edgeCount();
+    const float* normalX = window.getNormalX().data();
+    const float* normalY = window.getNormalY().data();
+    const float* offsets = window.getOffsets().data();
 
-        std::vector<Point> inputList = outputList;
-        outputList.clear();
+    // Chaque arête ajoute au plus un point par sommet du polygone d'entrée
+    for (auto& buffer : scratch.buffers) {
+        buffer.reserve(2 * subjectPolygon.size() + edgeCount);
+    }
 
-        if (inputList.empty()) {
-            return outputList;
-        }
+    std::vector<Point>* output = &scratch.buffers[0];
+    output->clear();
+    if (edgeCount == 0) {
+        output->assign(subjectPolygon.begin(), subjectPolygon.end());
+        return *output;
+    }
 
-        Point s = inputList.back();
+    // La première arête lit directement le sujet, les suivantes le tampon écrit par la précédente
+    const Point* input = subjectPolygon.data();
+    size_t inputSize = subjectPolygon.size();
 
-        for (const Point& e : inputList) {
-            // Si le point courant est à l'intérieur de l'arête de découpage
-            if (isInside(e, clipEdgeStart, clipEdgeEnd)) {
-                // Si le point précédent n'était pas à l'intérieur
-                if (!isInside(s, clipEdgeStart, clipEdgeEnd)) {
-                    // Ajouter le point d'intersection
-                    outputList.push_back(computeIntersection(s, e, clipEdgeStart, clipEdgeEnd));
-                }
-                // Ajouter le point courant
-                outputList.push_back(e);
+    // Pour chaque arête du polygone de découpage
+    for (size_t j = 0; j < edgeCount && inputSize > 0; j++) {
+        output = &scratch.buffers[j & 1];
+        output->clear();
+
+        // Distance signée à l'arête, une seule fois par sommet : un point est à l'intérieur
+        // si elle est négative ou nulle
+        const float nx = normalX[j], ny = normalY[j], c = offsets[j];
+        Point s = input[inputSize - 1];
+        float sDistance = nx * s.x + ny * s.y - c;
+
+        for (size_t i = 0; i < inputSize; i++) {
+            const Point& e = input[i];
+            float eDistance = nx * e.x + ny * e.y - c;
+
+            // Intersection du segment [s, e] avec l'arête, si ses extrémités sont de part et d'autre
+            if ((eDistance <= 0.0f) != (sDistance <= 0.0f)) {
+                float t = sDistance / (sDistance - eDistance);
+                output->emplace_back(s.x + t * (e.x - s.x), s.y + t * (e.y - s.y));
             }
-            // Si le point courant n'est pas à l'intérieur mais que le précédent l'était
-            else if (isInside(s, clipEdgeStart, clipEdgeEnd)) {
-                // Ajouter le point d'intersection
-                outputList.push_back(computeIntersection(s, e, clipEdgeStart, clipEdgeEnd));
+            // Ajouter le point courant s'il est à l'intérieur de l'arête de découpage
+            if (eDistance <= 0.0f) {
+                output->push_back(e);
             }
 
             s = e;
+            sDistance = eDistance;
         }
+
+        input = output->data();
+        inputSize = output->size();
     }
 
-    return outputList;
+    return *output;
+}
+
+void SutherlandHodgman::clipPolygons(const std::vector<Subject>& subjects, const ClipWindow& window,
+                                     std::vector<std::vector<Point>>& results, std::vector<Scratch>& arenas,
+                                     int threadCount) {
+    results.resize(subjects.size());
+
+    // Le travail se mesure en sommets : quelques gros profils justifient déjà plusieurs threads
+    size_t pointCount = 0;
+    for (const Subject& subject : subjects) {
+        pointCount += subject.points.size();
+    }
+    const int threads = std::min(parallelThreadCount(threadCount, pointCount, MIN_POINTS_PER_THREAD),
+                                 static_cast<int>(std::max<size_t>(1, subjects.size())));
+    if (arenas.size() < static_cast<size_t>(threads)) {
+        arenas.resize(threads);
+    }
+
+    parallelFor(subjects.size(), threads, [&](size_t begin, size_t end, int worker) {
+        Scratch& scratch = arenas[worker];
+        for (size_t i = begin; i < end; i++) {
+            const Subject& subject = subjects[i];
+            std::span<const Point> points = subject.points;
+            if (!subject.transform.isIdentity()) {
+                scratch.subject.clear();
+                for (const Point& p : points) {
+                    scratch.subject.push_back(subject.transform.apply(p));
+                }
+                points = scratch.subject;
+            }
+            const std::vector<Point>& clipped = clipPolygon(points, window, scratch);
+            results[i].assign(clipped.begin(), clipped.end());
+        }
+    });
 }
 
 // dans le cas de courbes ouvertes et non polygones.
 std::vector<std::vector<Point>> SutherlandHodgman::clipCurve(const std::vector<Point>& curve,
     const std::vector<Point>& clipPolygon) {
+    return SutherlandHodgman::clipCurve(curve, ClipWindow(clipPolygon));
+}
+
+std::vector<std::vector<Point>> SutherlandHodgman::clipCurve(const std::vector<Point>& curve, const ClipWindow& window) {
     std::vector<std::vector<Point>> clippedSegments;
 
-    if (curve.size() < 2 || clipPolygon.size() < 3) {
+    if (curve.size() < 2 || window.size() < 3) {
         return clippedSegments;
     }
 
@@ -76,9 +129,7 @@ std::vector<std::vector<Point>> SutherlandHodgman::clipCurve(const std::vector<P
         std::vector<Point> segment = {curve[i], curve[i+1]};
 
         // Découper ce segment avec Sutherland-Hodgman
-        //std::vector<Point> clippedSegment = clipPolygon(segment, clipPolygon);
-        std::vector<Point> clippedSegment = SutherlandHodgman::clipPolygon(segment, clipPolygon);
-
+        std::vector<Point> clippedSegment = SutherlandHodgman::clipPolygon(segment, window);
 
         // Si le segment n'est pas entièrement découpé, l'ajouter aux résultats
         if (!clippedSegment.empty()) {
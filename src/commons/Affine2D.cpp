@@ -0,0 +1,69 @@
+﻿#include "../../include/commons/Affine2D.h"
+#include <cmath>
+
+Affine2D::Affine2D() : a(1.0f), b(0.0f), c(0.0f), d(1.0f), tx(0.0f), ty(0.0f) {}
+
+Affine2D::Affine2D(float a, float b, float c, float d, float tx, float ty)
+        : a(a), b(b), c(c), d(d), tx(tx), ty(ty) {}
+
+Affine2D Affine2D::translation(float dx, float dy) {
+    return Affine2D(1.0f, 0.0f, 0.0f, 1.0f, dx, dy);
+}
+
+Affine2D Affine2D::scaling(float sx, float sy) {
+    return Affine2D(sx, 0.0f, 0.0f, sy, 0.0f, 0.0f);
+}
+
+Affine2D Affine2D::rotation(float radians) {
+    float cosA = std::cos(radians);
+    float sinA = std::sin(radians);
+    return Affine2D(cosA, sinA, -sinA, cosA, 0.0f, 0.0f);
+}
+
+Affine2D Affine2D::shearing(float shx, float shy) {
+    return Affine2D(1.0f, shy, shx, 1.0f, 0.0f, 0.0f);
+}
+
+Affine2D Affine2D::about(const Affine2D& transform, const Point& pivot) {
+    return translation(pivot.x, pivot.y) * transform * translation(-pivot.x, -pivot.y);
+}
+
+Affine2D Affine2D::operator*(const Affine2D& o) const {
+    return Affine2D(a * o.a + c * o.b,
+                    b * o.a + d * o.b,
+                    a * o.c + c * o.d,
+                    b * o.c + d * o.d,
+                    a * o.tx + c * o.ty + tx,
+                    b * o.tx + d * o.ty + ty);
+}
+
+Point Affine2D::apply(const Point& p) const {
+    return Point(a * p.x + c * p.y + tx, b * p.x + d * p.y + ty);
+}
+
+float Affine2D::determinant() const {
+    return a * d - b * c;
+}
+
+Affine2D Affine2D::inverse() const {
+    float det = determinant();
+    if (std::fabs(det) < 1e-12f) {
+        return Affine2D(); // Non inversible : on renvoie l'identité
+    }
+    float invDet = 1.0f / det;
+    float ia = d * invDet;
+    float ib = -b * invDet;
+    float ic = -c * invDet;
+    float id = a * invDet;
+    return Affine2D(ia, ib, ic, id, -(ia * tx + ic * ty), -(ib * tx + id * ty));
+}
+
+bool Affine2D::isIdentity() const {
+    return a == 1.0f && b == 0.0f && c == 0.0f && d == 1.0f && tx == 0.0f && ty == 0.0f;
+}
+
+void Affine2D::toColumnMajor(float out[9]) const {
+    out[0] = a;  out[1] = b;  out[2] = 0.0f;
+    out[3] = c;  out[4] = d;  out[5] = 0.0f;
+    out[6] = tx; out[7] = ty; out[8] = 1.0f;
+}
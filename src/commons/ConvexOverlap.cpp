@@ -0,0 +1,231 @@
+﻿#include "../../include/commons/ConvexOverlap.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr float EPSILON = 1e-7f;
+
+    float dot(const Point& a, const Point& b) {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    float length(const Point& v) {
+        return std::sqrt(dot(v, v));
+    }
+
+    // Sommet le plus bas (puis le plus à gauche) : point de départ de la fusion des arêtes
+    size_t lowestVertex(const std::vector<Point>& polygon) {
+        size_t lowest = 0;
+        for (size_t i = 1; i < polygon.size(); i++) {
+            if (polygon[i].y < polygon[lowest].y ||
+                (polygon[i].y == polygon[lowest].y && polygon[i].x < polygon[lowest].x)) {
+                lowest = i;
+            }
+        }
+        return lowest;
+    }
+
+    // Distance de l'origine à un segment (différence de Minkowski dégénérée)
+    // (en double : la distance sert d'axe séparateur, l'annulation en float est trop visible)
+    Point closestToOrigin(const Point& a, const Point& b) {
+        double abx = double(b.x) - a.x, aby = double(b.y) - a.y;
+        double lengthSquared = abx * abx + aby * aby;
+        if (lengthSquared < EPSILON) {
+            return a;
+        }
+        double t = std::clamp(-(a.x * abx + a.y * aby) / lengthSquared, 0.0, 1.0);
+        return Point(static_cast<float>(a.x + abx * t), static_cast<float>(a.y + aby * t));
+    }
+}
+
+OverlapResult ConvexOverlap::test(const std::vector<Point>& a, const std::vector<Point>& b,
+                                  const Point* cachedAxis) {
+    OverlapResult result;
+    if (a.empty() || b.empty()) {
+        return result;
+    }
+
+    // L'axe de l'image précédente sépare encore les polygones dans la plupart des cas
+    if (cachedAxis && separatedAlong(a, b, *cachedAxis, result)) {
+        return result;
+    }
+
+    std::vector<Point> difference = minkowskiDifference(a, b);
+
+    if (difference.size() < 3) {
+        // Polygones réduits à des points ou à des segments parallèles
+        Point closest = difference.size() == 1 ? difference[0]
+                                               : closestToOrigin(difference[0], difference[1]);
+        float gap = length(closest);
+        result.overlap = gap < EPSILON;
+        result.distance = gap;
+        result.axis = gap < EPSILON ? Point() : closest * (-1.0f / gap);
+    } else {
+        // Test des axes séparateurs : chaque arête de A - B porte une normale d'arête de A ou de B.
+        // L'origine est dans A - B si elle est du côté intérieur de toutes les arêtes.
+        float best = -std::numeric_limits<float>::max();
+        Point bestNormal;
+        for (size_t i = 0; i < difference.size(); i++) {
+            const Point& v = difference[i];
+            Point edge = difference[(i + 1) % difference.size()] - v;
+            float edgeLength = length(edge);
+            if (edgeLength < EPSILON) {
+                continue;
+            }
+            Point normal(edge.y / edgeLength, -edge.x / edgeLength); // normale sortante
+            float signedDistance = -dot(normal, v);
+            if (signedDistance > best) {
+                best = signedDistance;
+                bestNormal = normal;
+            }
+        }
+
+        if (best > 0.0f) {
+            // Origine extérieure : le point de A - B le plus proche donne la distance exacte
+            // entre A et B, et l'axe séparateur de plus grand écart (de A vers B : -closest)
+            float bestSquared = std::numeric_limits<float>::max();
+            for (size_t i = 0; i < difference.size(); i++) {
+                const Point& v = difference[i];
+                const Point& w = difference[(i + 1) % difference.size()];
+                Point candidate = closestToOrigin(v, w);
+                float squared = dot(candidate, candidate);
+                if (squared >= bestSquared) {
+                    continue;
+                }
+                bestSquared = squared;
+                result.distance = std::sqrt(squared);
+                Point edge = w - v;
+                float edgeLength = length(edge);
+                bool onVertex = (candidate.x == v.x && candidate.y == v.y) ||
+                                (candidate.x == w.x && candidate.y == w.y);
+                if (!onVertex && edgeLength >= EPSILON) {
+                    // Point intérieur à l'arête : l'axe est sa normale sortante, calculée exactement
+                    result.axis = Point(edge.y / edgeLength, -edge.x / edgeLength);
+                    result.distance = -dot(result.axis, v);
+                } else {
+                    result.axis = candidate * (-1.0f / result.distance);
+                }
+            }
+        } else {
+            // Origine intérieure : l'arête la plus proche donne la pénétration minimale ;
+            // les points de A - B vérifient dot(n, a - b) <= -best, n est orienté de A vers B
+            result.overlap = true;
+            result.depth = -best;
+            result.axis = bestNormal;
+        }
+    }
+
+    if (result.overlap) {
+        result.aContainsB = a.size() >= 3 && containsAll(a, b);
+        result.bContainsA = b.size() >= 3 && containsAll(b, a);
+    }
+    return result;
+}
+
+bool ConvexOverlap::separatedAlong(const std::vector<Point>& a, const std::vector<Point>& b,
+                                   const Point& axis, OverlapResult& result) {
+    float axisLength = length(axis);
+    if (axisLength < EPSILON) {
+        return false;
+    }
+    Point n = axis * (1.0f / axisLength);
+
+    float minA = std::numeric_limits<float>::max(), maxA = -minA;
+    float minB = minA, maxB = -minA;
+    for (const Point& p : a) {
+        float d = dot(n, p);
+        minA = std::min(minA, d);
+        maxA = std::max(maxA, d);
+    }
+    for (const Point& p : b) {
+        float d = dot(n, p);
+        minB = std::min(minB, d);
+        maxB = std::max(maxB, d);
+    }
+
+    if (maxA < minB) {
+        result.axis = n;
+        result.distance = minB - maxA;
+        return true;
+    }
+    if (maxB < minA) {
+        result.axis = n * -1.0f;
+        result.distance = minA - maxB;
+        return true;
+    }
+    return false;
+}
+
+std::vector<Point> ConvexOverlap::minkowskiDifference(const std::vector<Point>& a, const std::vector<Point>& b) {
+    // -B est aussi convexe et dans le sens trigonométrique
+    std::vector<Point> negated(b.size());
+    for (size_t i = 0; i < b.size(); i++) {
+        negated[i] = b[i] * -1.0f;
+    }
+
+    const size_t n = a.size(), m = negated.size();
+    const size_t startA = lowestVertex(a), startB = lowestVertex(negated);
+    auto vertexA = [&](size_t i) { return a[(startA + i) % n]; };
+    auto vertexB = [&](size_t j) { return negated[(startB + j) % m]; };
+
+    // Fusion des arêtes des deux polygones par angle croissant
+    std::vector<Point> result;
+    result.reserve(n + m);
+    size_t i = 0, j = 0;
+    while (i < n || j < m) {
+        result.push_back(vertexA(i) + vertexB(j));
+        float turn = (vertexA(i + 1) - vertexA(i)).cross(vertexB(j + 1) - vertexB(j));
+        if (j >= m || (i < n && turn > 0.0f)) {
+            i++;
+        } else if (i >= n || turn < 0.0f) {
+            j++;
+        } else {
+            i++;
+            j++;
+        }
+    }
+
+    // Sommets répétés par les arêtes nulles des polygones dégénérés
+    result.erase(std::unique(result.begin(), result.end(), [](const Point& p, const Point& q) {
+        return std::fabs(p.x - q.x) < EPSILON && std::fabs(p.y - q.y) < EPSILON;
+    }), result.end());
+    while (result.size() > 1 && std::fabs(result.front().x - result.back().x) < EPSILON &&
+           std::fabs(result.front().y - result.back().y) < EPSILON) {
+        result.pop_back();
+    }
+    return result;
+}
+
+bool ConvexOverlap::containsPoint(const std::vector<Point>& polygon, const Point& p) {
+    const size_t n = polygon.size();
+    if (n < 3) {
+        return false;
+    }
+
+    // Recherche dichotomique du secteur (polygon[0], polygon[k], polygon[k + 1]) contenant p
+    const Point& origin = polygon[0];
+    Point d = p - origin;
+    if ((polygon[1] - origin).cross(d) < -EPSILON || (polygon[n - 1] - origin).cross(d) > EPSILON) {
+        return false;
+    }
+    size_t low = 1, high = n - 1;
+    while (high - low > 1) {
+        size_t mid = (low + high) / 2;
+        if ((polygon[mid] - origin).cross(d) >= 0.0f) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return (polygon[high] - polygon[low]).cross(p - polygon[low]) >= -EPSILON;
+}
+
+bool ConvexOverlap::containsAll(const std::vector<Point>& polygon, const std::vector<Point>& points) {
+    for (const Point& p : points) {
+        if (!containsPoint(polygon, p)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,225 @@
+﻿#include "../../include/commons/DynamicAABBTree.h"
+#include <algorithm>
+#include <cassert>
+
+DynamicAABBTree::DynamicAABBTree(float margin)
+        : root(NULL_NODE), freeList(NULL_NODE), proxyCount(0), margin(margin) {}
+
+void DynamicAABBTree::clear() {
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    proxyCount = 0;
+}
+
+int DynamicAABBTree::allocateNode() {
+    if (freeList == NULL_NODE) {
+        nodes.emplace_back();
+        return static_cast<int>(nodes.size()) - 1;
+    }
+    int nodeId = freeList;
+    freeList = nodes[nodeId].parent;
+    nodes[nodeId] = Node();
+    return nodeId;
+}
+
+void DynamicAABBTree::freeNode(int nodeId) {
+    nodes[nodeId].parent = freeList;
+    nodes[nodeId].height = -1;
+    freeList = nodeId;
+}
+
+int DynamicAABBTree::createProxy(const AABB& box, int userData) {
+    int leaf = allocateNode();
+    nodes[leaf].box = box.expanded(margin);
+    nodes[leaf].userData = userData;
+    nodes[leaf].height = 0;
+    insertLeaf(leaf);
+    proxyCount++;
+    return leaf;
+}
+
+void DynamicAABBTree::destroyProxy(int proxyId) {
+    assert(proxyId >= 0 && proxyId < static_cast<int>(nodes.size()) && nodes[proxyId].isLeaf());
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    proxyCount--;
+}
+
+bool DynamicAABBTree::moveProxy(int proxyId, const AABB& box) {
+    // La boîte élargie contient encore la courbe : rien à faire
+    if (nodes[proxyId].box.contains(box)) {
+        return false;
+    }
+    removeLeaf(proxyId);
+    nodes[proxyId].box = box.expanded(margin);
+    insertLeaf(proxyId);
+    return true;
+}
+
+int DynamicAABBTree::getUserData(int proxyId) const {
+    return nodes[proxyId].userData;
+}
+
+const AABB& DynamicAABBTree::getFatAABB(int proxyId) const {
+    return nodes[proxyId].box;
+}
+
+int DynamicAABBTree::getProxyCount() const {
+    return proxyCount;
+}
+
+int DynamicAABBTree::getHeight() const {
+    return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+void DynamicAABBTree::insertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descente vers le frère le moins coûteux (heuristique de surface, en 2D le périmètre)
+    const AABB leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        float perimeter = node.box.perimeter();
+        float combined = node.box.merged(leafBox).perimeter();
+
+        // Coût de créer un nouveau parent pour ce nœud et la feuille
+        float cost = 2.0f * combined;
+        // Coût minimal de pousser la feuille plus bas dans l'arbre
+        float inheritance = 2.0f * (combined - perimeter);
+
+        auto childCost = [&](int child) {
+            float merged = nodes[child].box.merged(leafBox).perimeter();
+            return nodes[child].isLeaf() ? merged + inheritance
+                                         : merged - nodes[child].box.perimeter() + inheritance;
+        };
+        float cost1 = childCost(node.child1);
+        float cost2 = childCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    // Nouveau parent commun à la feuille et au frère choisi
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = nodes[sibling].box.merged(leafBox);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].child1 == sibling) {
+        nodes[oldParent].child1 = newParent;
+    } else {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    refit(nodes[leaf].parent);
+}
+
+void DynamicAABBTree::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // Le frère prend la place du parent
+    if (nodes[grandParent].child1 == parent) {
+        nodes[grandParent].child1 = sibling;
+    } else {
+        nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+void DynamicAABBTree::refit(int nodeId) {
+    // Remonte jusqu'à la racine en rééquilibrant et en recalculant boîtes et hauteurs
+    while (nodeId != NULL_NODE) {
+        nodeId = balance(nodeId);
+        Node& node = nodes[nodeId];
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+        node.box = nodes[node.child1].box.merged(nodes[node.child2].box);
+        nodeId = node.parent;
+    }
+}
+
+// Rotation gauche ou droite si les sous-arbres de A diffèrent de plus d'un niveau.
+// Retourne la nouvelle racine du sous-arbre.
+int DynamicAABBTree::balance(int iA) {
+    Node& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int iB = A.child1;
+    int iC = A.child2;
+    int heightDiff = nodes[iC].height - nodes[iB].height;
+    if (heightDiff >= -1 && heightDiff <= 1) {
+        return iA;
+    }
+
+    // Le sous-arbre le plus haut (iUp) remonte à la place de A
+    bool rotateUpC = heightDiff > 1;
+    int iUp = rotateUpC ? iC : iB;
+    int iStay = rotateUpC ? iB : iC;
+    Node& up = nodes[iUp];
+    int iF = up.child1;
+    int iG = up.child2;
+
+    up.child1 = iA;
+    up.parent = A.parent;
+    A.parent = iUp;
+
+    if (up.parent == NULL_NODE) {
+        root = iUp;
+    } else if (nodes[up.parent].child1 == iA) {
+        nodes[up.parent].child1 = iUp;
+    } else {
+        nodes[up.parent].child2 = iUp;
+    }
+
+    // Le plus haut des petits-enfants reste sous iUp, l'autre descend sous A
+    int iHigh = nodes[iF].height > nodes[iG].height ? iF : iG;
+    int iLow = iHigh == iF ? iG : iF;
+    up.child2 = iHigh;
+    if (rotateUpC) {
+        A.child2 = iLow;
+    } else {
+        A.child1 = iLow;
+    }
+    nodes[iLow].parent = iA;
+
+    A.box = nodes[iStay].box.merged(nodes[iLow].box);
+    A.height = 1 + std::max(nodes[iStay].height, nodes[iLow].height);
+    up.box = A.box.merged(nodes[iHigh].box);
+    up.height = 1 + std::max(A.height, nodes[iHigh].height);
+
+    return iUp;
+}
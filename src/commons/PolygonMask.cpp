@@ -0,0 +1,149 @@
+﻿#include "../../include/commons/PolygonMask.h"
+#include <algorithm>
+#include <cmath>
+
+PolygonMask::PolygonMask() : resolution(0), cellWidth(0.0f), cellHeight(0.0f) {}
+
+void PolygonMask::build(const std::vector<Point>& points, int requestedResolution) {
+    polygon = points;
+    centerInside.clear();
+    cellStart.clear();
+    edges.clear();
+    if (polygon.size() < 3) {
+        return;
+    }
+
+    bounds = AABB::fromPoints(polygon);
+    const size_t edgeCount = polygon.size();
+    resolution = requestedResolution > 0 ? requestedResolution
+                                         : std::clamp(static_cast<int>(4.0f * std::sqrt(static_cast<float>(edgeCount))), 8, 256);
+    // Cases non dégénérées même pour un lasso plat
+    cellWidth = std::max((bounds.max.x - bounds.min.x) / resolution, 1e-6f);
+    cellHeight = std::max((bounds.max.y - bounds.min.y) / resolution, 1e-6f);
+    const int cellCount = resolution * resolution;
+
+    // Arêtes de chaque case (deux passes : comptage puis remplissage, stockage contigu)
+    std::vector<uint32_t> counts(cellCount + 1, 0);
+    auto forEachCell = [&](size_t e, auto callback) {
+        const Point& a = polygon[e];
+        const Point& b = polygon[(e + 1) % edgeCount];
+        int x0 = std::clamp(static_cast<int>((std::min(a.x, b.x) - bounds.min.x) / cellWidth), 0, resolution - 1);
+        int x1 = std::clamp(static_cast<int>((std::max(a.x, b.x) - bounds.min.x) / cellWidth), 0, resolution - 1);
+        int y0 = std::clamp(static_cast<int>((std::min(a.y, b.y) - bounds.min.y) / cellHeight), 0, resolution - 1);
+        int y1 = std::clamp(static_cast<int>((std::max(a.y, b.y) - bounds.min.y) / cellHeight), 0, resolution - 1);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                if (segmentTouchesCell(a, b, cx, cy)) {
+                    callback(cellIndex(cx, cy));
+                }
+            }
+        }
+    };
+    for (size_t e = 0; e < edgeCount; e++) {
+        forEachCell(e, [&](int c) { counts[c + 1]++; });
+    }
+    cellStart.resize(cellCount + 1);
+    cellStart[0] = 0;
+    for (int c = 0; c < cellCount; c++) {
+        cellStart[c + 1] = cellStart[c] + counts[c + 1];
+    }
+    edges.resize(cellStart[cellCount]);
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t e = 0; e < edgeCount; e++) {
+        forEachCell(e, [&](int c) { edges[fill[c]++] = static_cast<uint32_t>(e); });
+    }
+
+    // État des centres : un balayage horizontal par ligne de cases
+    centerInside.assign(cellCount, 0);
+    std::vector<float> crossings;
+    for (int cy = 0; cy < resolution; cy++) {
+        float y = bounds.min.y + (cy + 0.5f) * cellHeight;
+        crossings.clear();
+        for (size_t e = 0; e < edgeCount; e++) {
+            const Point& a = polygon[e];
+            const Point& b = polygon[(e + 1) % edgeCount];
+            if ((a.y > y) != (b.y > y)) {
+                crossings.push_back(a.x + (y - a.y) / (b.y - a.y) * (b.x - a.x));
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        size_t k = 0;
+        for (int cx = 0; cx < resolution; cx++) {
+            float x = bounds.min.x + (cx + 0.5f) * cellWidth;
+            while (k < crossings.size() && crossings[k] < x) {
+                k++;
+            }
+            centerInside[cellIndex(cx, cy)] = static_cast<uint8_t>(k & 1);
+        }
+    }
+}
+
+bool PolygonMask::contains(const Point& p) const {
+    if (polygon.size() < 3 || !bounds.contains(p)) {
+        return false;
+    }
+    int cx = std::min(static_cast<int>((p.x - bounds.min.x) / cellWidth), resolution - 1);
+    int cy = std::min(static_cast<int>((p.y - bounds.min.y) / cellHeight), resolution - 1);
+    int c = cellIndex(cx, cy);
+    bool inside = centerInside[c] != 0;
+    if (cellStart[c] == cellStart[c + 1]) {
+        return inside;
+    }
+
+    // Le segment centre -> p reste dans la case : seules ses arêtes peuvent le couper
+    Point center = cellCenter(cx, cy);
+    const size_t edgeCount = polygon.size();
+    for (uint32_t i = cellStart[c]; i < cellStart[c + 1]; i++) {
+        uint32_t e = edges[i];
+        if (segmentsCross(center, p, polygon[e], polygon[(e + 1) % edgeCount])) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool PolygonMask::containsBox(const AABB& box) const {
+    if (polygon.size() < 3 || !bounds.contains(box)) {
+        return false;
+    }
+    int x0 = std::min(static_cast<int>((box.min.x - bounds.min.x) / cellWidth), resolution - 1);
+    int x1 = std::min(static_cast<int>((box.max.x - bounds.min.x) / cellWidth), resolution - 1);
+    int y0 = std::min(static_cast<int>((box.min.y - bounds.min.y) / cellHeight), resolution - 1);
+    int y1 = std::min(static_cast<int>((box.max.y - bounds.min.y) / cellHeight), resolution - 1);
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int c = cellIndex(cx, cy);
+            if (!centerInside[c] || cellStart[c] != cellStart[c + 1]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Point PolygonMask::cellCenter(int cx, int cy) const {
+    return Point(bounds.min.x + (cx + 0.5f) * cellWidth, bounds.min.y + (cy + 0.5f) * cellHeight);
+}
+
+bool PolygonMask::segmentTouchesCell(const Point& a, const Point& b, int cx, int cy) const {
+    // Test de séparation sur la normale du segment (les axes x et y sont couverts par l'intervalle de cases)
+    float minX = bounds.min.x + cx * cellWidth, maxX = minX + cellWidth;
+    float minY = bounds.min.y + cy * cellHeight, maxY = minY + cellHeight;
+    float nx = a.y - b.y, ny = b.x - a.x;
+    float d0 = nx * (minX - a.x) + ny * (minY - a.y);
+    float d1 = nx * (maxX - a.x) + ny * (minY - a.y);
+    float d2 = nx * (maxX - a.x) + ny * (maxY - a.y);
+    float d3 = nx * (minX - a.x) + ny * (maxY - a.y);
+    return std::min({d0, d1, d2, d3}) <= 0.0f && std::max({d0, d1, d2, d3}) >= 0.0f;
+}
+
+bool PolygonMask::segmentsCross(const Point& p1, const Point& p2, const Point& q1, const Point& q2) {
+    auto side = [](const Point& a, const Point& b, const Point& c) {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    };
+    float d1 = side(q1, q2, p1), d2 = side(q1, q2, p2);
+    float d3 = side(p1, p2, q1), d4 = side(p1, p2, q2);
+    // Extrémités de l'arête comptées d'un seul côté (demi-ouvert) pour ne pas compter deux fois un sommet
+    return ((d1 > 0.0f) != (d2 > 0.0f)) && ((d3 > 0.0f) != (d4 > 0.0f));
+}
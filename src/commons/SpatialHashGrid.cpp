@@ -0,0 +1,98 @@
+﻿#include "../../include/commons/SpatialHashGrid.h"
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+        : cellSize(cellSize), inverseCellSize(1.0f / cellSize) {}
+
+void SpatialHashGrid::insert(uint64_t id, const Point& point) {
+    if (entryOf.count(id)) {
+        move(id, point);
+        return;
+    }
+    uint32_t e = static_cast<uint32_t>(entries.size());
+    entries.push_back({id, point, cellOf(point), 0});
+    entryOf[id] = e;
+    link(e);
+}
+
+void SpatialHashGrid::move(uint64_t id, const Point& point) {
+    auto it = entryOf.find(id);
+    if (it == entryOf.end()) {
+        insert(id, point);
+        return;
+    }
+
+    Entry& entry = entries[it->second];
+    entry.point = point;
+    uint64_t cell = cellOf(point);
+    // La plupart des déplacements restent dans la même case
+    if (cell != entry.cell) {
+        unlink(it->second);
+        entry.cell = cell;
+        link(it->second);
+    }
+}
+
+void SpatialHashGrid::remove(uint64_t id) {
+    auto it = entryOf.find(id);
+    if (it == entryOf.end()) {
+        return;
+    }
+    uint32_t e = it->second;
+    entryOf.erase(it);
+    unlink(e);
+
+    // Le dernier élément prend la place libérée
+    uint32_t last = static_cast<uint32_t>(entries.size() - 1);
+    if (e != last) {
+        entries[e] = entries[last];
+        entryOf[entries[e].id] = e;
+        cells[entries[e].cell][entries[e].slotInCell] = e;
+    }
+    entries.pop_back();
+}
+
+bool SpatialHashGrid::contains(uint64_t id) const {
+    return entryOf.count(id) != 0;
+}
+
+const Point& SpatialHashGrid::position(uint64_t id) const {
+    return entries[entryOf.at(id)].point;
+}
+
+void SpatialHashGrid::clear() {
+    entries.clear();
+    entryOf.clear();
+    cells.clear();
+}
+
+void SpatialHashGrid::setCellSize(float size) {
+    if (size <= 0.0f || size == cellSize) {
+        return;
+    }
+    cellSize = size;
+    inverseCellSize = 1.0f / size;
+
+    cells.clear();
+    for (uint32_t e = 0; e < entries.size(); e++) {
+        entries[e].cell = cellOf(entries[e].point);
+        link(e);
+    }
+}
+
+void SpatialHashGrid::link(uint32_t entry) {
+    std::vector<uint32_t>& cell = cells[entries[entry].cell];
+    entries[entry].slotInCell = static_cast<uint32_t>(cell.size());
+    cell.push_back(entry);
+}
+
+void SpatialHashGrid::unlink(uint32_t entry) {
+    auto it = cells.find(entries[entry].cell);
+    std::vector<uint32_t>& cell = it->second;
+    uint32_t slot = entries[entry].slotInCell;
+    cell[slot] = cell.back();
+    entries[cell[slot]].slotInCell = slot;
+    cell.pop_back();
+    if (cell.empty()) {
+        cells.erase(it);
+    }
+}